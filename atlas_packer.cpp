@@ -0,0 +1,38 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include <stdio.h>
+#include <filesystem>
+
+#include "./headers/texture_atlas.h"
+#include "./headers/game/sprite_atlas.h"
+
+// Packs the game's sprites into atlas pages ahead of time, run from the repository root.
+// The game falls back to packing at startup when no prebuilt atlas is found.
+int main( int argc, char* args[] )
+{
+	int imgFlags = IMG_INIT_PNG;
+	if( !( IMG_Init( imgFlags ) & imgFlags ) )
+	{
+		printf( "SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError() );
+		return 1;
+	}
+
+	TextureAtlas atlas;
+	if( !atlas.pack( game::getAtlasSpritePaths(), game::SPRITE_ATLAS_PAGE_SIZE ) )
+	{
+		printf( "Failed to pack sprite atlas!\n" );
+		IMG_Quit();
+		return 1;
+	}
+
+	std::filesystem::create_directories( std::filesystem::path( game::SPRITE_ATLAS_PREFIX ).parent_path() );
+
+	bool saved = atlas.save( game::SPRITE_ATLAS_PREFIX );
+	printf( "Packed %d sprites into %d page(s) at %s\n", atlas.getRegionAmount(), atlas.getPageAmount(), game::SPRITE_ATLAS_PREFIX.c_str() );
+
+	atlas.free();
+	IMG_Quit();
+
+	return saved ? 0 : 1;
+}
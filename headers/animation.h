@@ -7,6 +7,7 @@
 
 #include "./texture.h"
 #include "./utils/vector2d.h"
+#include "./utils/constants.h"
 
 class Animation
 {
@@ -31,7 +32,7 @@ class Animation
         Texture sheetTexture;
         
         int frameAmount;
-        int skipFrames = 8; // TODO: Hardcoded value
+        int skipFrames = ANIMATION_SKIP_FRAMES;
         int frame;
         
         std::vector<SDL_Rect> frames;
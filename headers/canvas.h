@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include <vector>
 #include "./ui_object.h"
+#include "./utils/span.h"
 
 class Canvas
 {
@@ -20,6 +21,8 @@ class Canvas
 
         void addObj(UIObject* obj);
 
+        Span<UIObject* const> getObjs() const;
+
     private:
         std::vector<UIObject*> objs;
         bool isActive = true;
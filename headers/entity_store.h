@@ -0,0 +1,179 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "./texture.h"
+#include "./utils/vector2d.h"
+
+// Same value as GameObject::getId, 0 is never handed out
+typedef Uint32 Entity;
+
+enum RotDir
+{
+    RIGHT = 1,
+    LEFT = -1,
+    NONE = 0
+};
+
+struct Transform
+{
+    Vector2D position;
+    Vector2D size;
+    float rotation = 0.0f;
+
+    // State at the start of the last simulation step, used for interpolation
+    Vector2D previousPosition;
+    float previousRotation = 0.0f;
+    bool hasPreviousState = false;
+};
+
+// Velocities and rotation speeds are in units per 60 Hz frame
+struct Motion
+{
+    Vector2D velocity;
+    float rotationSpeed = 1;
+    RotDir rotationDirection = RotDir::NONE;
+};
+
+struct Sprite
+{
+    Texture texture;
+    std::string texturePath;
+};
+
+struct PhysicsBody
+{
+    Vector2D acceleration{0, 0};
+    float mass = 1.0f;
+    bool hasFriction = true;
+
+    // Only simulated bodies are stepped by EntityStore::stepBodies
+    bool simulated = false;
+};
+
+// Components of one type in fixed size pages indexed by slot. Pages are never
+// moved or freed, so a component stays put while its slot is in use whatever
+// else is added or removed. A removed slot is reset and left for the next add.
+template <typename T>
+class ComponentArray
+{
+    public:
+        // Returns the existing component if slot already has one
+        T& add(Uint32 slot)
+        {
+            while (slot >= pages.size() * PAGE_SIZE)
+            {
+                pages.emplace_back(new T[PAGE_SIZE]());
+                used.resize(pages.size() * PAGE_SIZE, false);
+            }
+
+            if (!used[slot])
+            {
+                used[slot] = true;
+                amount++;
+            }
+
+            return get(slot);
+        }
+
+        void remove(Uint32 slot)
+        {
+            if (!has(slot))
+            {
+                return;
+            }
+
+            // Drops whatever the component holds, like a sprite's texture
+            get(slot) = T();
+            used[slot] = false;
+            amount--;
+        }
+
+        bool has(Uint32 slot) const
+        {
+            return slot < used.size() && used[slot];
+        }
+
+        T& get(Uint32 slot)
+        {
+            return pages[slot / PAGE_SIZE][slot % PAGE_SIZE];
+        }
+
+        // Every slot below this may be in use, check with has
+        Uint32 getSlotAmount() const
+        {
+            return used.size();
+        }
+
+        size_t size() const
+        {
+            return amount;
+        }
+
+    private:
+        static const Uint32 PAGE_SIZE = 256;
+
+        std::vector<std::unique_ptr<T[]>> pages;
+        std::vector<bool> used;
+        size_t amount = 0;
+};
+
+// Owns the data of every GameObject in per-component arrays so systems walk
+// memory linearly instead of chasing object pointers. GameObject and its
+// subclasses are facades that look their components up by id.
+//
+// Each live entity holds one slot, the same in every array, and slots of
+// destroyed entities are reused. So memory follows the most entities alive at
+// once, not every id ever handed out, and references to an entity's components
+// stay valid until that entity is destroyed.
+class EntityStore
+{
+    public:
+        static EntityStore& get();
+
+        // Every entity has a transform, motion and sprite
+        void create(Entity entity);
+        void destroy(Entity entity);
+
+        // Copies every component of from onto to, adding a body if from has one
+        void copy(Entity from, Entity to);
+
+        Transform& getTransform(Entity entity);
+        Motion& getMotion(Entity entity);
+        Sprite& getSprite(Entity entity);
+
+        PhysicsBody& addBody(Entity entity);
+        PhysicsBody& getBody(Entity entity);
+        bool hasBody(Entity entity);
+
+        int getSize();
+
+        // Systems, run once per simulation step over the simulated bodies
+        void storePreviousStates();
+        void stepBodies(float deltaTime);
+
+        // One body's step, shared by stepBodies and PhysicsObject
+        static void moveBody(Transform& transform, Motion& motion, PhysicsBody& body, float deltaTime);
+        static void rotateBody(Transform& transform, Motion& motion, float deltaTime);
+
+    private:
+        EntityStore();
+
+        Uint32 getSlot(Entity entity);
+
+        std::unordered_map<Entity, Uint32> slots; // Live entities only
+        std::vector<Uint32> freeSlots;
+        Uint32 slotAmount = 0;
+
+        ComponentArray<Transform> transforms;
+        ComponentArray<Motion> motions;
+        ComponentArray<Sprite> sprites;
+        ComponentArray<PhysicsBody> bodies;
+};
+
+#endif // ENTITY_STORE_H
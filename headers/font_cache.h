@@ -0,0 +1,39 @@
+#ifndef FONT_CACHE_H
+#define FONT_CACHE_H
+
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <map>
+
+// Shares one TTF_Font per (path, point size) between every Text that loads it.
+// Entries are reference counted and closed as soon as the last user releases them.
+class FontCache
+{
+    public:
+        struct Entry
+        {
+            std::string path;
+            int size = 0;
+            TTF_Font* font = NULL;
+            int refCount = 0;
+        };
+
+        static FontCache& get();
+
+        Entry* acquire(std::string path, int size);
+        void retain(Entry* entry);
+        void release(Entry* entry);
+
+        // Closes every font, must be called before TTF_Quit.
+        // Entries stay valid until released, with a NULL font.
+        void closeAll();
+
+        int getSize();
+
+    private:
+        FontCache();
+
+        std::map<std::pair<std::string, int>, Entry> entries;
+};
+
+#endif // FONT_CACHE_H
@@ -4,6 +4,7 @@
 #include <SDL2/SDL_render.h>
 
 #include "../game_object.h"
+#include "../sprite_states.h"
 #include "./furniture.h"
 
 namespace game
@@ -11,10 +12,22 @@ namespace game
     class Cursor : public GameObject
     {
     public:
+        enum HandState
+        {
+            HAND_POINT  = 0,
+            HAND_OPEN   = 1,
+            HAND_CLOSED = 2
+        };
+
         Cursor(std::string name);
-        void updateTexture(SDL_Renderer *renderer);
+        void loadStates(SDL_Renderer *renderer);
+        void updateTexture();
         bool isClosed = false;
         bool isHovering = false;
+
+    private:
+        SpriteStates states;
+        bool statesApplied = false;
     };
 }
 
@@ -17,24 +17,50 @@
 #include "../../headers/scene.h"
 #include "../../headers/image.h"
 #include "../../headers/audio_source.h"
+#include "../../headers/sprite_batch.h"
+#include "../../headers/spatial_grid.h"
 
 namespace game
 {
     class Game
     {
     public:
+        // A null renderer runs the game headless: no drawing, no audio
         Game(SDL_Renderer *renderer);
         ~Game();
-        bool loadMedia();
+        bool loadMedia(Canvas &canvas);
         void handleEvent(SDL_Event *event);
-        void update(float avgFPS);
-        void render();
+        // Advances the simulation by one fixed SIMULATION_STEP
+        void update();
+        void updateFPS(float avgFPS);
+        // alpha is how far the renderer is between the last two steps
+        void render(float alpha);
         void reset();
 
+        bool isHeadless();
+
+        // Scripted play for headless runs, same effects as the mouse and keyboard
+        int getBoxAmount();
+        // False when furniture is already unpacked or there is no such box
+        bool unpackBox(int index);
+        Furniture* getCurrentFurniture();
+        // Pulls the unpacked furniture towards target each step, like dragging it there
+        void dragFurniture(Vector2D target);
+        void releaseFurniture();
+        void placeFurniture();
+
+        const std::vector<Room*>& getRooms();
+        int getScore();
+        bool isFurnished();
+
     private:
+        void unpack(Box *box);
         void placeFurn();
+        void playSound(int index);
 
         SDL_Renderer *renderer = nullptr;
+        bool headless = false;
+        SpriteBatch batch;
         
         Text fpsText;
         Cursor cursor;
@@ -52,7 +78,15 @@ namespace game
         std::vector<Room*> rooms;
         std::vector<GameObject*> walls;
 
-        GameObject* checkpoint = nullptr;
+        // Broad phase for furniture against furniture and walls
+        SpatialGrid collisionGrid{64};
+        std::vector<GameObject*> collisionCandidates;
+
+        std::vector<GameObject*> checkpoints;
+
+        // Set by dragFurniture, takes the place of the mouse
+        bool hasDragTarget = false;
+        Vector2D dragTarget;
 
         Box *hoveredBox = nullptr;
         Furniture *hoveredFurn = nullptr;
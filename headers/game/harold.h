@@ -3,6 +3,7 @@
 
 #include "../animation.h"
 #include "../game_object.h"
+#include "../sprite_states.h"
 
 namespace game
 {
@@ -12,9 +13,10 @@ namespace game
         Harold(Vector2D pos);
         void loadAnimation(SDL_Renderer *renderer);
         void renderAnimation(SDL_Renderer *renderer);
-        void updateTexture(SDL_Renderer *renderer);
+        void loadStates(SDL_Renderer *renderer);
+        void updateTexture();
         void handleEvent(SDL_Event* event) override;
-        void move();
+        void move(float deltaTime) override;
         
         bool canControl = false;
     private:
@@ -25,6 +27,15 @@ namespace game
 		bool playAnimation = false;
 
         Texture idleTexture;
+
+        static const int IDLE_STATE = 0;
+        static const int WALK_FRAMES = 4;
+        static const int SPRITE_SCALE = 2;
+        // Seconds of simulation Harold has been walking, drives the walk frames
+        float walkTime = 0.0f;
+
+        SpriteStates states;
+        bool statesApplied = false;
     };
 }
 
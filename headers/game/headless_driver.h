@@ -0,0 +1,36 @@
+#ifndef GAME_HEADLESS_DRIVER_H
+#define GAME_HEADLESS_DRIVER_H
+
+#include <random>
+
+#include "./game.h"
+#include "../utils/vector2d.h"
+
+namespace game
+{
+    // Plays a headless Game through its scripted API so furniture physics and
+    // scoring run without input. Each box is unpacked, dragged to a room and
+    // placed, usually a room it fits in. The choices depend only on the seed.
+    class HeadlessDriver
+    {
+    public:
+        HeadlessDriver(Game &game, unsigned int seed);
+
+        // Takes this step's action, then steps the game
+        void step();
+
+        int getPlacedAmount();
+
+    private:
+        void unpackNext();
+
+        Game &game;
+        std::mt19937 generator;
+
+        Vector2D target;
+        int dragSteps = 0;
+        int placedAmount = 0;
+    };
+}
+
+#endif
@@ -19,6 +19,12 @@ namespace game
     {
     public:
         HouseGenerator();
+        // Lays out the given rooms instead of the game's random house
+        HouseGenerator(std::vector<RoomId> roomOrder, Rectangle houseSize);
+        ~HouseGenerator();
+
+        HouseGenerator(const HouseGenerator&) = delete;
+        HouseGenerator& operator=(const HouseGenerator&) = delete;
 
         std::vector<GameObject*> generateWalls();
         std::vector<Room*> generateRooms();
@@ -36,6 +42,9 @@ namespace game
         RoomHandler* roomHandler = nullptr;
 
         std::string dir = "";
+
+    private:
+        void generate(std::vector<RoomId> roomOrder);
     };
 }
 
@@ -14,6 +14,7 @@ namespace game
     {
     public:
         Room(int x, int y, int w, int h, std::string n, int xOff, int yOff);
+        ~Room();
 
         bool isInside(int x, int y);
 
@@ -0,0 +1,16 @@
+#ifndef GAME_SPRITE_ATLAS_H
+#define GAME_SPRITE_ATLAS_H
+
+#include <string>
+#include <vector>
+
+namespace game
+{
+    const std::string SPRITE_ATLAS_PREFIX = "./resources/atlas/sprites";
+    const int SPRITE_ATLAS_PAGE_SIZE = 2048;
+
+    // Every image packed into the sprite atlas, shared by the game and atlas_packer
+    std::vector<std::string> getAtlasSpritePaths();
+}
+
+#endif
@@ -5,7 +5,12 @@
 #include <cmath>
 #include <vector>
 #include "./texture.h"
+#include "./name_table.h"
+#include "./entity_store.h"
 #include "./utils/vector2d.h"
+#include "./utils/obb.h"
+#include "./utils/span.h"
+#include "./utils/constants.h"
 
 enum State
 {
@@ -16,13 +21,8 @@ enum State
     TOTAL             = 4
 }; 
 
-enum RotDir
-{
-    RIGHT = 1,
-    LEFT = -1,
-    NONE = 0
-};
-
+// Facade over one entity in the EntityStore: position, motion and sprite live
+// in packed component arrays, only rarely used state is kept in the object.
 class GameObject
 {
     public:
@@ -30,6 +30,15 @@ class GameObject
         GameObject(int x, int y, int w, int h);
         GameObject(Vector2D topLeft, Vector2D bottomRight);
         GameObject(Vector2D pos, Vector2D s, Vector2D vel, std::string n, std::string path);
+        GameObject(const GameObject& other);
+        virtual ~GameObject();
+
+        GameObject& operator=(const GameObject& other);
+
+        // References into EntityStore, valid until this object is destroyed
+        Transform& getTransform();
+        Motion& getMotion();
+        Sprite& getSprite();
 
         Texture& getTexture();
 
@@ -94,8 +103,10 @@ class GameObject
             }
         }
 
-        void setTexture(Texture texture);
+        // Takes the texture over, pass Texture::share() to keep using the original
+        void setTexture(Texture&& texture);
         void setTexturePath(std::string path);
+        std::string getTexturePath();
 
         bool loadTexture(SDL_Renderer* renderer, std::string path);
         bool loadTexture(SDL_Renderer* renderer);
@@ -106,12 +117,17 @@ class GameObject
         void setVelocity(Vector2D velocity);
         void setSize(Vector2D scale);
 
-        void render(SDL_Renderer* renderer);
+        // alpha blends between the previous and current simulation step
+        void render(SDL_Renderer* renderer, float alpha = 1.0f);
+
+        void storePreviousState();
+        Vector2D getInterpolatedPosition(float alpha);
+        float getInterpolatedRotation(float alpha);
 
         SDL_Rect toBox();
 
         bool hasCollision(GameObject* other);
-        bool hasCollision(std::vector<Vector2D> cornersB);
+        bool hasCollision(GameObject* other, Vector2D& normal, float& depth);
 
         bool isInside(int x, int y);
         
@@ -123,9 +139,15 @@ class GameObject
 
         State getCurrentState();
         
+        // Unnamed objects get "Object<id>", built on every call, so keep it to tools and the editor
         std::string getName();
+        bool hasName();
+
+        // Unique for the lifetime of the program and never reused, also the EntityStore entity
+        Entity getId();
 
         void setRotation(float value);
+        float getRotation();
 
         void increaseRotation(float amount);
 
@@ -134,21 +156,26 @@ class GameObject
         void setRotationDirection(RotDir dir);
         void setRotationSpeed(float speed);
 
-        virtual void move()
+        // Velocities and rotation speeds are in units per 60 Hz frame,
+        // deltaTime is in seconds and scales them to the step length
+        virtual void move(float deltaTime)
         {
-            getPosition().increaseX(getVelocity().getX());
-            getPosition().increaseY(getVelocity().getY());
+            float frames = deltaTime * SCREEN_FPS;
+            getPosition().increaseX(getVelocity().getX() * frames);
+            getPosition().increaseY(getVelocity().getY() * frames);
         }
 
-        virtual void rotate()
+        virtual void rotate(float deltaTime)
         {
-            switch(rotationDirection)
+            float frames = deltaTime * SCREEN_FPS;
+            Motion& motion = getMotion();
+            switch(motion.rotationDirection)
             {
                 case RotDir::RIGHT:
-                    increaseRotation(rotationSpeed);
+                    increaseRotation(motion.rotationSpeed * frames);
                 break;
                 case RotDir::LEFT:
-                    decreaseRotation(rotationSpeed);
+                    decreaseRotation(motion.rotationSpeed * frames);
                 break;
                 case RotDir::NONE:
                 break;
@@ -160,37 +187,35 @@ class GameObject
             
         }
 
-        virtual void handleCollisions(std::vector<GameObject*> others)
+        virtual void handleCollisions(Span<GameObject* const> others)
         {
 
         }
 
         bool isMoving();
 
-        std::vector<Vector2D> getCorners();
-        bool debugMode = false;
+        bool isStaticObject();
 
-    protected:
-        float rotation = 0.0f;
-        float rotationSpeed = 1;
-        RotDir rotationDirection = RotDir::NONE;
+        const OBB& getOBB();
+        bool debugMode = false;
 
     private:
-        bool isStatic;
+        bool isStatic = false;
+
+        // Recomputed by getOBB() only when position, size or rotation changed
+        OBB obb;
+        bool obbValid = false;
+        Vector2D obbPosition;
+        Vector2D obbSize;
+        float obbRotation = 0.0f;
 
         Texture debugTexture;
 
-		State currentState;
+		State currentState = MOUSE_OUT;
         bool toggle = false;
 
-        Texture texture;
-        std::string texturePath;
-
-        std::string name;
-
-        Vector2D position;
-        Vector2D velocity;
-        Vector2D size;
+        Entity id = 0;
+        Uint32 nameId = NameTable::NO_NAME;
 };
 
 #endif // GAMEOBJECT_H
\ No newline at end of file
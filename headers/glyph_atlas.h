@@ -0,0 +1,56 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <map>
+
+// All printable ASCII glyphs of one (font, size) rasterized once into a single texture.
+// Strings are drawn as one batch of textured quads with SDL_RenderGeometry (SDL 2.0.18+).
+class GlyphAtlas
+{
+    public:
+        static GlyphAtlas* get(std::string path, int size);
+
+        bool build(SDL_Renderer* renderer, TTF_Font* font);
+        bool isBuilt();
+
+        bool canRender(const std::string& content);
+
+        void render(const std::string& content, int x, int y, SDL_Color color, SDL_Renderer* renderer);
+
+        int getWidth(const std::string& content);
+        int getHeight();
+
+        void free();
+
+    private:
+        GlyphAtlas();
+
+        static const int FIRST_GLYPH = 32;
+        static const int LAST_GLYPH  = 126;
+        static const int GLYPH_AMOUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+        static const int ATLAS_WIDTH = 512;
+        static const int GLYPH_PADDING = 1;
+
+        struct Glyph
+        {
+            SDL_Rect clip = { 0, 0, 0, 0 };
+            int advance = 0;
+        };
+
+        Glyph glyphs[ GLYPH_AMOUNT ];
+
+        SDL_Texture* texture = NULL;
+        int width = 0;
+        int height = 0;
+        int lineHeight = 0;
+
+        // Reused between calls so drawing a string allocates nothing once warmed up
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+};
+
+#endif // GLYPH_ATLAS_H
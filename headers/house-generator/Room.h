@@ -7,6 +7,8 @@
 #include <ostream>
 #include <cmath>
 
+#include "../utils/span.h"
+
 
 struct LineSegment
 {
@@ -27,7 +29,8 @@ public:
 	
 	bool doorSuccess = true;
 
-	std::vector<LineSegment> lineSegments;
+	// One segment, or two around the door
+	Span<const LineSegment> getLineSegments() const;
 	void generateLineSegments();
 
 	bool isHorizontal = false;
@@ -36,6 +39,9 @@ public:
 	bool openRandomDoors = false;
 	float forceDoorChance = 0.5;
 private:
+	LineSegment lineSegments[2];
+	int lineSegmentCount = 0;
+
 	float length();
 	float calculateDoorLocation();
 };
@@ -59,28 +65,16 @@ public:
 
 struct GeneratedRoom
 {	
-	GeneratedRoom(float x, float y, float width, float height, RoomId roomId);
+	// Copies roomId without its children, those stay in the room tree
+	GeneratedRoom(float x, float y, float width, float height, const RoomId& roomId);
 	
 	float x, y;
 	float width, height;
 	RoomId roomId;
 
-	void addNeighbor(GeneratedRoom &neighbor);
-	std::vector<GeneratedRoom> getNeighbors() const;
-
-	void addConnectedNeighbor(const GeneratedRoom& neighbor);
-	std::vector<GeneratedRoom> getConnectedNeighbors() const;
 	bool isConnectedToStart = false;
 
 	friend std::ostream& operator<<(std::ostream& os, const GeneratedRoom& room);
-
-	bool isVisited = false; // Internal check
-
-private:
-	std::vector<GeneratedRoom> neighbors;
-	std::vector<GeneratedRoom> connectedNeighbors; // Neighbors with open door to room !! TODO !!
-	
-	std::vector<LineSegment> walls;
 };
 
 #endif
\ No newline at end of file
@@ -8,39 +8,71 @@
 
 #include "Room.h"
 #include "SquarifiedTreemap.hpp"
-#include <optional>
+#include "../utils/span.h"
+#include "../utils/arena.h"
 
 class RoomHandler
 {
+private:
+	// Backs every container below, declared first so it outlives them.
+	// All of a house's generation data goes when the handler does.
+	Arena arena;
+
 public:
 	RoomHandler(std::vector<RoomId> roomTree, Rectangle houseSize);
 	void createRooms();
 	void createOuterWalls();
 
-	std::vector<Wall> walls;
+	ArenaVector<Wall> walls;
+
+	// Valid until the handler is destroyed or generates again
+	Span<const GeneratedRoom> getRooms() const;
 
-	std::vector<GeneratedRoom> getRooms();
+	// Two leaf rooms sharing a wall, wall is an index into walls
+	struct RoomEdge
+	{
+		int first;
+		int second;
+		int wall;
+	};
 
-	std::optional<GeneratedRoom> findLargestRoom(std::vector<RoomId>& rooms);
-	std::optional<GeneratedRoom> findRoomWithId(RoomId id);
+	Span<const RoomEdge> getEdges() const;
+
+	// Indices into getRooms() of the leaf rooms touching room
+	Span<const int> getNeighbors(int room) const;
+	// Neighbors reachable through a door in the shared wall
+	Span<const int> getConnectedNeighbors(int room) const;
+
+	// NULL when no generated room matches
+	const GeneratedRoom* findLargestRoom(const std::vector<RoomId>& rooms) const;
+	const GeneratedRoom* findRoomWithId(const RoomId& id) const;
 
 	std::string dir = "";
 
 private:
 	std::vector<RoomId> roomTree;
-	void processNodes(std::vector<RoomId>& nodes, std::optional<GeneratedRoom> parent);
+	void processNodes(const ArenaVector<RoomId*>& nodes, int parentIndex); // -1 for the house itself
 	Rectangle houseSize; // houseSize.Width, houseSize.Height (I think)
-	std::vector<GeneratedRoom> rooms;
-	std::vector<RoomId> areas;
+	ArenaVector<GeneratedRoom> rooms;
+	ArenaVector<const RoomId*> areas; // Into roomTree
 
 
 	// Return a random wall number. 
 	// Left, right, top, bottom = 1, 2, 3, 4 respectively.
-	static uint8_t randomWallNumber(std::vector<uint8_t> validWalls); 
+	static uint8_t randomWallNumber(Span<const uint8_t> validWalls);
 
 	std::string entranceRoomName = "LivingRoom";
 
 	void findRoomNeighbors();
+	size_t countOuterWalls() const;
+	void buildAdjacency();
+	bool isConnected(const RoomEdge& edge) const;
+
+	ArenaVector<RoomEdge> edges;
+	ArenaVector<int> neighborOffsets;
+	ArenaVector<int> neighbors;
+	ArenaVector<int> connectedOffsets;
+	ArenaVector<int> connectedNeighbors;
 };
 
 #endif
\ No newline at end of file
@@ -15,6 +15,9 @@
 #include <assert.h>
 #include <utility>
 #include <algorithm>
+#include <limits>
+
+#include "../utils/span.h"
 
 using Number = float;
 template <typename T>
@@ -227,7 +230,9 @@ inline Array<Rectangle> TravelLayout(Layout* CurrentLayout, size_t count)
     return Result;
 }
 
-inline Array<Rectangle> SolveSquarifiedTreemap(const Array<Number>& Datas, const Rectangle& Container)
+// Original solver, one heap allocated Layout per row and a re-sum of the row
+// per datum. Kept as the reference SolveSquarifiedTreemap is checked against.
+inline Array<Rectangle> SolveSquarifiedTreemapReference(const Array<Number>& Datas, const Rectangle& Container)
 {
     Number TotalData = std::accumulate(Datas.begin(), Datas.end(), Zero);
     UniquePtr<Layout> OriginalLayout = MakeUnique<Layout>();
@@ -246,4 +251,101 @@ inline Array<Rectangle> SolveSquarifiedTreemap(const Array<Number>& Datas, const
     return TravelLayout(OriginalLayout.get(), Datas.size());
 }
 
+// Writes one finished row, same arithmetic as Layout::GetLayoutRectangles
+inline void LayoutRow(const Number* RowDatas, size_t Count, Number RowTotal, const Rectangle& Container,
+    Number TotalData, Orientation DataOrientation, Rectangle* Result)
+{
+    Number LastTotal = RowTotal;
+    Rectangle LastBlock = Container * (LastTotal / TotalData);
+    for (size_t i = 0; i < Count; i++)
+    {
+        Rectangle ThisBlock = LastBlock * MakePair(DataOrientation, RowDatas[i] / LastTotal);
+        LastBlock = LastBlock - ThisBlock;
+        LastTotal = LastTotal - RowDatas[i];
+        Result[i] = ThisBlock;
+    }
+}
+
+// Same layout as SolveSquarifiedTreemapReference without building the Layout
+// chain. The open row is a range of Datas with a running total, and each row
+// is written into Result as soon as it closes, so Result[i] is the rectangle
+// of Datas[i]. Result must hold Datas.size() rectangles.
+//
+// Row totals are summed once instead of per datum. The reference adds the new
+// datum first when trying it in the row, so results are only bit-identical
+// while the partial sums are exact, as they are for the integer room sizes.
+inline void SolveSquarifiedTreemap(Span<const Number> Datas, const Rectangle& Container, Span<Rectangle> Result)
+{
+    assert(Result.size() >= Datas.size());
+
+    Number TotalData = std::accumulate(Datas.begin(), Datas.end(), Zero);
+
+    // What is left of the container, and the data that goes in it
+    Rectangle RowContainer = Container;
+    Number RowTotalData = TotalData;
+
+    Orientation DataOrientation = Orientation::Horizontal;
+    size_t RowStart = 0;
+    Number RowTotal = Zero;
+
+    for (size_t i = 0; i < Datas.size(); i++)
+    {
+        Number Data = Datas[i];
+        if (RowStart == i)
+        {
+            RowTotal = RowTotal + Data;
+            Rectangle NewData = RowContainer * (Data / RowTotalData);
+            DataOrientation = NewData.GetOrientation();
+            if (RowContainer.GetOrientation() == DataOrientation && RowTotalData > Data)
+            {
+                LayoutRow(&Datas[RowStart], 1, RowTotal, RowContainer, RowTotalData, DataOrientation, &Result[RowStart]);
+                RowContainer = RowContainer - NewData;
+                RowTotalData = RowTotalData - Data;
+                RowStart = i + 1;
+                RowTotal = Zero;
+            }
+        }
+        else
+        {
+            Number LastData = Datas[i - 1];
+
+            Number FirstRatio = Zero;
+            {
+                Number CurrentTotal = RowTotal + Data;
+                Rectangle CurrentBlock = RowContainer * (CurrentTotal / RowTotalData);
+                FirstRatio = (CurrentBlock * MakePair(DataOrientation, LastData / CurrentTotal)).GetAspectRatio();
+            }
+
+            Rectangle CurrentBlock = RowContainer * (RowTotal / RowTotalData);
+            Number SecondRatio = (CurrentBlock * MakePair(DataOrientation, LastData / RowTotal)).GetAspectRatio();
+
+            if (FirstRatio < SecondRatio)
+            {
+                RowTotal = RowTotal + Data;
+            }
+            else
+            {
+                LayoutRow(&Datas[RowStart], i - RowStart, RowTotal, RowContainer, RowTotalData, DataOrientation, &Result[RowStart]);
+                RowContainer = RowContainer - CurrentBlock;
+                RowTotalData = RowTotalData - RowTotal;
+                DataOrientation = (RowContainer * (Data / RowTotalData)).GetOrientation();
+                RowStart = i;
+                RowTotal = Zero + Data;
+            }
+        }
+    }
+
+    if (RowStart < Datas.size())
+    {
+        LayoutRow(&Datas[RowStart], Datas.size() - RowStart, RowTotal, RowContainer, RowTotalData, DataOrientation, &Result[RowStart]);
+    }
+}
+
+inline Array<Rectangle> SolveSquarifiedTreemap(const Array<Number>& Datas, const Rectangle& Container)
+{
+    Array<Rectangle> Result(Datas.size());
+    SolveSquarifiedTreemap(Span<const Number>(Datas), Container, Span<Rectangle>(Result));
+    return Result;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef MAP_FILE_H
+#define MAP_FILE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+// Binary tile map: a MapFileHeader followed by width * height one-byte tile IDs,
+// row by row. Header fields are little endian. MapFile memory maps the file so
+// the tiles are used in place and opening costs the same for any map size.
+struct MapFileHeader
+{
+    char magic[4];
+    Uint32 version;
+    Uint32 width;
+    Uint32 height;
+    Uint32 tilesetId;
+    Uint32 dataOffset; // From the start of the file
+};
+
+const char MAP_FILE_MAGIC[4] = { 'L', 'D', 'M', 'P' };
+const Uint32 MAP_FILE_VERSION = 1;
+const std::string MAP_FILE_EXTENSION = ".bmap";
+
+class MapFile
+{
+    public:
+        MapFile();
+        ~MapFile();
+
+        MapFile(const MapFile&) = delete;
+        MapFile& operator=(const MapFile&) = delete;
+
+        bool open(std::string path);
+        void close();
+
+        bool isOpen();
+
+        int getWidth();
+        int getHeight();
+        int getTilesetId();
+
+        // Valid until close(), row by row
+        const Uint8* getTiles();
+
+        static bool write(std::string path, int width, int height, int tilesetId, const std::vector<Uint8>& tiles);
+
+        // Parses a text .map file, the first non-empty row decides the width
+        static bool readText(std::string path, int tileTypes, int& width, int& height, std::vector<Uint8>& tiles);
+
+    private:
+        const Uint8* data = NULL;
+        size_t size = 0;
+
+        int width = 0;
+        int height = 0;
+        int tilesetId = 0;
+        const Uint8* tiles = NULL;
+
+#if defined(_WIN32)
+        void* fileHandle = NULL;
+        void* mappingHandle = NULL;
+#else
+        int fileDescriptor = -1;
+#endif
+};
+
+#endif // MAP_FILE_H
@@ -0,0 +1,32 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Interns object names so each distinct name is stored once and objects only
+// keep a small id. Most objects never get a name, see GameObject::getName.
+class NameTable
+{
+    public:
+        static constexpr Uint32 NO_NAME = 0;
+
+        static NameTable& get();
+
+        // The same string always gives the same id, an empty string gives NO_NAME
+        Uint32 intern(const std::string& name);
+
+        const std::string& getString(Uint32 id);
+
+        int getSize();
+
+    private:
+        NameTable();
+
+        std::vector<std::string> names; // Indexed by id, names[NO_NAME] is empty
+        std::unordered_map<std::string, Uint32> ids;
+};
+
+#endif // NAME_TABLE_H
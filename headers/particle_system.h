@@ -0,0 +1,59 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "./texture.h"
+#include "./sprite_batch.h"
+
+// Fixed-capacity particle emitter. Particles are plain arrays (structure of
+// arrays) instead of objects, dead ones are swapped out with the last live
+// one, and every emitter shares its textures through the texture cache.
+// All particles are drawn in one batch.
+class ParticleSystem
+{
+    public:
+        ParticleSystem(int capacity);
+
+        bool loadTextures(SDL_Renderer* renderer, const std::vector<std::string>& colorPaths, std::string shimmerPath);
+        void freeTextures();
+
+        void setAlpha(Uint8 alpha);
+
+        // Spawns up to amount particles around (x, y), stops when the pool is full
+        void emit(int x, int y, int amount);
+        // Tops the pool up to capacity, for emitters that never run dry
+        void fill(int x, int y);
+
+        void update();
+        void render(SDL_Renderer* renderer, int offsetX = 0, int offsetY = 0);
+
+        void clear();
+
+        int getCount();
+        int getCapacity();
+
+    private:
+        static const int LIFETIME = 10;     // Frames a particle lives
+        static const int SPAWN_OFFSET = 5;  // Spawn area starts this far up and left of the emitter
+        static const int SPAWN_SPREAD = 25; // and is this wide and tall
+        static const int START_FRAMES = 5;  // Particles start at a random age below this
+
+        void kill(int index);
+
+        int capacity;
+        int count = 0;
+
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<Uint8> frames;
+        std::vector<Uint8> colors;
+
+        std::vector<Texture> colorTextures;
+        Texture shimmerTexture;
+
+        SpriteBatch batch;
+};
+
+#endif // PARTICLE_SYSTEM_H
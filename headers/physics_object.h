@@ -15,132 +15,62 @@ class PhysicsObject : public GameObject
         PhysicsObject(int x, int y, int w, int h, float m);
         PhysicsObject(Vector2D pos, Vector2D s, Vector2D vel, std::string n, std::string path, float m);
 
-        void rotate() override
+        // Same step EntityStore::stepBodies runs for every simulated body
+        void rotate(float deltaTime) override
         {
-            if(rotationDirection != RotDir::NONE)
-            {
-                float localVel = rotationSpeed*rotationSpeed;
-                float friction = localVel * 0.0025;
-
-                rotationSpeed-=friction;
-
-                if(rotationSpeed <= 0.25 && rotationSpeed >= -0.25)
-                {
-                    rotationSpeed = 0;
-                    setRotationDirection(RotDir::NONE);
-                }
-
-                switch(rotationDirection)
-                {
-                    case RotDir::RIGHT:
-                        increaseRotation(rotationSpeed);
-                    break;
-                    case RotDir::LEFT:
-                        decreaseRotation(rotationSpeed);
-                    break;
-                }
-            }
+            EntityStore::rotateBody(getTransform(), getMotion(), deltaTime);
         }
 
-        void move() override
+        void move(float deltaTime) override
         {
-            if(hasFriction) 
-            {
-                float velSqrMagnitude = getVelocity().getX()*getVelocity().getX() + getVelocity().getY()*getVelocity().getY();
-                bool isNotMoving = velSqrMagnitude <= 1; // TODO: decide better value
-
-                if (isNotMoving)
-                {
-                    acceleration.setX(-getVelocity().getX());
-                    acceleration.setY(-getVelocity().getY());
-                    getVelocity().increaseX(acceleration.getX());
-                    getVelocity().increaseY(acceleration.getY());
-                }
-                else
-                {
-                    float fricCoefficient = 0.0025f * mass; // TODO: decide better value
-                    float fricMagnitude = fricCoefficient * 9.82f;
-
-                    Vector2D fricDirection = getVelocity().getNormalizedVector() * -1;
-                    Vector2D friction = fricDirection * fricMagnitude;
-                    acceleration.set(friction.getX(), friction.getY());
-
-                    getVelocity().increaseX(acceleration.getX());
-                    getVelocity().increaseY(acceleration.getY());
-                }
-            }
-
-            Vector2D newPosition = getPosition() + getVelocity();
-
-            if (newPosition.getX() <= 0)
-            {
-                float magnitude = abs(getVelocity().getX());
-                getVelocity().setX(magnitude);
-                float distToBound = 0 - newPosition.getX();
-                newPosition.increaseX(distToBound);
-            }
-            else if (newPosition.getX() >= SCREEN_WIDTH - getSize().getX())
-            {
-                float magnitude = abs(getVelocity().getX());
-                getVelocity().setX(-magnitude);
-                float distToBound = newPosition.getX() + getSize().getX() - SCREEN_WIDTH;
-                newPosition.decreaseX(distToBound);
-            }
-
-            if (newPosition.getY() <= 0)
-            {
-                float magnitude = abs(getVelocity().getY());
-                getVelocity().setY(magnitude);
-                float distToBound = 0 - newPosition.getY();
-                newPosition.increaseY(distToBound);
-            }
-            else if (newPosition.getY() >= SCREEN_HEIGHT - getSize().getY())
-            {
-                float magnitude = abs(getVelocity().getY());
-                getVelocity().setY(-magnitude);
-                float distToBound = newPosition.getY() + getSize().getY() - SCREEN_HEIGHT;
-                newPosition.decreaseY(distToBound);
-            }
-
-            setPosition(newPosition);
-
-            if(getVelocity().getX() <= 0.1 && getVelocity().getX() >= -0.1)
-            {
-                getVelocity().setX(0);
-            }
-
-            if(getVelocity().getY() <= 0.1 && getVelocity().getY() >= -0.1) 
-            {
-                getVelocity().setY(0);
-            }
+            EntityStore::moveBody(getTransform(), getMotion(), getBody(), deltaTime);
         }
 
-        void handleCollisions(std::vector<GameObject*> others) override
+        void handleCollisions(Span<GameObject* const> others) override
         {
             if(isMoving())
             {
+                Vector2D normal;
+                float depth;
+
                 for (auto* other: others)
                 {
                     if(other != this)
                     {
-                        if(hasCollision(other->getCorners()))
+                        if(hasCollision(other, normal, depth))
                         {
-                            other->getVelocity().set(getVelocity().getX(), getVelocity().getY());
-                            auto gen = std::bind(std::uniform_int_distribution<>(0,1),std::default_random_engine());
-                            bool b = gen();
-
-                            if(b)
+                            // Push apart along the contact normal, static objects don't budge
+                            if(other->isStaticObject())
                             {
-                                other->setRotationDirection(RotDir::LEFT);
-                                other->setRotationSpeed(1);
+                                getPosition() += normal * depth;
                             }
                             else
                             {
-                                other->setRotationDirection(RotDir::RIGHT);
-                                other->setRotationSpeed(1);
+                                getPosition() += normal * (depth / 2);
+                                other->getPosition() -= normal * (depth / 2);
+
+                                other->getVelocity().set(getVelocity().getX(), getVelocity().getY());
+                                auto gen = std::bind(std::uniform_int_distribution<>(0,1),std::default_random_engine());
+                                bool b = gen();
+
+                                if(b)
+                                {
+                                    other->setRotationDirection(RotDir::LEFT);
+                                    other->setRotationSpeed(1);
+                                }
+                                else
+                                {
+                                    other->setRotationDirection(RotDir::RIGHT);
+                                    other->setRotationSpeed(1);
+                                }
+                            }
+
+                            // Bounce off the contact surface if still heading into it
+                            float approach = getVelocity().dot(normal);
+                            if(approach < 0)
+                            {
+                                getVelocity() -= normal * (2 * approach);
                             }
-                            
-                            getVelocity()*=-1;
                         }
 
                     }
@@ -152,12 +82,11 @@ class PhysicsObject : public GameObject
 
         float getMass();
 
-    private:
-        Vector2D acceleration{0, 0};
+        // Simulated bodies are stepped by EntityStore::stepBodies every simulation step
+        void setSimulated(bool state);
+        bool isSimulated();
 
-        bool hasFriction = true;
-        
-        float mass;
+        PhysicsBody& getBody();
 };
 
 #endif
\ No newline at end of file
@@ -2,8 +2,9 @@
 #define PLAYER_H
 
 #include <SDL2/SDL.h>
-#include "./tile.h"
-#include "./particle.h"
+#include "./tile_map.h"
+#include "./game_object.h"
+#include "./particle_system.h"
 #include "./texture.h"
 
 #include "./utils/constants.h"
@@ -19,13 +20,13 @@ class Player : public GameObject
         static const int TOTAL_PARTICLES = 20;
 
 		Player();
-		~Player();
 
 		void handleEvent( SDL_Event& e );
 
-		void move( Tile *tiles[] );
+		void move( TileMap& map );
 
-		void setCamera( SDL_Rect& camera );
+		// Keeps the camera inside map
+		void setCamera( SDL_Rect& camera, TileMap& map );
 
 		void render( SDL_Rect& camera, SDL_Renderer* gRenderer );
 
@@ -33,14 +34,14 @@ class Player : public GameObject
         
 		Animation* getAnimation();
 
-		Particle* particles[ TOTAL_PARTICLES ];
+		ParticleSystem particles{ TOTAL_PARTICLES };
     private:
 		std::vector<Animation*> animations;
         Animation* activeAnimation;
 
 		bool playAnimation = false;
 
-		void renderParticles(SDL_Renderer* gRenderer);
+		void renderParticles( SDL_Rect& camera, SDL_Renderer* gRenderer );
 };
 
 #endif // PLAYER_H
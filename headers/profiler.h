@@ -0,0 +1,83 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Hierarchical frame profiler. Scopes nest by call order and accumulate their
+// time over a frame, the last HISTORY_FRAMES frames are kept for statistics.
+// Every scope is also a slice in the trace while TraceRecorder is recording.
+class Profiler
+{
+    public:
+        struct Stats
+        {
+            float min = 0.0f;
+            float avg = 0.0f;
+            float p99 = 0.0f;
+            int frames = 0; // Recent frames the scope actually ran in
+        };
+
+        static constexpr int HISTORY_FRAMES = 240;
+        static constexpr int FRAME_SCOPE = 0;
+
+        static Profiler& get();
+
+        void beginFrame();
+        void endFrame();
+
+        void beginScope(const char* name);
+        void endScope();
+
+        int getScopeAmount();
+        const char* getScopeName(int scope);
+        int getScopeDepth(int scope);
+
+        // Times are in milliseconds
+        Stats getStats(int scope);
+
+    private:
+        Profiler();
+
+        struct Scope
+        {
+            const char* name;
+            int parent;
+            int depth;
+            float frameTime = 0.0f;
+            bool ranThisFrame = false;
+            std::vector<float> history; // Negative when the scope didn't run
+        };
+
+        int findScope(int parent, const char* name);
+        float toMilliseconds(Uint64 ticks);
+
+        std::vector<Scope> scopes;
+        std::vector<int> stack;
+        std::vector<Uint64> startStack;
+        std::vector<float> sortScratch;
+
+        Uint64 frameStart = 0;
+        int historyIndex = 0;
+};
+
+// Times the enclosing block as a child of the innermost open scope
+class ProfileScope
+{
+    public:
+        ProfileScope(const char* name)
+        {
+            Profiler::get().beginScope(name);
+        }
+
+        ~ProfileScope()
+        {
+            Profiler::get().endScope();
+        }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+#endif // PROFILER_H
@@ -0,0 +1,42 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "./ui_object.h"
+#include "./text.h"
+
+// Canvas object listing every profiler scope with its min/avg/p99 time,
+// toggled with F3. Text is only rebuilt every REFRESH_FRAMES frames.
+class ProfilerOverlay : public UIObject
+{
+    public:
+        ProfilerOverlay(int x, int y, std::string fontPath, int fontSize);
+
+        void handleEvent(SDL_Event* e) override;
+        void render(SDL_Renderer* renderer) override;
+
+        void setVisible(bool state);
+        bool isVisible();
+
+    private:
+        void refresh(SDL_Renderer* renderer);
+        Text& getLine(std::vector<Text>& lines, int index);
+
+        static const int REFRESH_FRAMES = 30;
+        static const int INDENT = 12;
+        static const int STATS_OFFSET = 220;
+
+        std::string fontPath;
+        int fontSize;
+
+        std::vector<Text> names;
+        std::vector<Text> stats;
+        int lineAmount = 0;
+
+        int framesUntilRefresh = 0;
+        bool visible = false;
+};
+
+#endif // PROFILER_OVERLAY_H
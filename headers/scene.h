@@ -7,7 +7,14 @@
 #include <sstream>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "./game_object.h"
+#include "./utils/span.h"
+
+// Scenes ending in SCENE_FILE_EXTENSION are binary: a header, a string table of
+// names and texture paths, then one fixed-size record per object. Anything else
+// is read and written as the text format.
+const std::string SCENE_FILE_EXTENSION = ".bscene";
 
 class Scene
 {
@@ -24,18 +31,26 @@ class Scene
         void addObj(GameObject* obj);
 
         void loadTextures(SDL_Renderer* renderer);
-        void load(std::string path);
+        bool load(std::string path);
 
         void createEmptyObject();
 
-        void save(std::string path);
+        bool save(std::string path);
 
-        std::vector<GameObject*> getObjs();
+        // Valid until the next addObj or load
+        Span<GameObject* const> getObjs() const;
 
+        // Looked up in a hash index kept by addObj, the first object with a name wins
         GameObject* getObjFromName(std::string name);
 
     private:
+        bool loadText(std::istream& file);
+        bool loadBinary(std::istream& file);
+        void saveText(std::ostream& file);
+        void saveBinary(std::ostream& file);
+
         std::vector<GameObject*> objs;
+        std::unordered_map<std::string, GameObject*> nameIndex;
         bool isActive = true;
 };
 
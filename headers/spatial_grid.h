@@ -0,0 +1,53 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include "./game_object.h"
+
+// Uniform grid broad phase. Objects are bucketed by the cells their rotated bounding box
+// covers and only rebucketed when that cell range changes, so still objects cost nothing.
+class SpatialGrid
+{
+    public:
+        SpatialGrid(int cellSize);
+
+        void insert(GameObject* obj);
+        void remove(GameObject* obj);
+        void update(GameObject* obj);
+
+        void clear();
+
+        // Every other object sharing a cell with obj, each once
+        void query(GameObject* obj, std::vector<GameObject*>& candidates);
+
+        int getObjectAmount();
+
+    private:
+        struct CellRange
+        {
+            int minX, minY;
+            int maxX, maxY;
+
+            bool operator==(const CellRange& other) const
+            {
+                return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+            }
+        };
+
+        CellRange getCellRange(GameObject* obj);
+
+        static int64_t getCellKey(int x, int y);
+
+        void addToCells(GameObject* obj, const CellRange& range);
+        void removeFromCells(GameObject* obj, const CellRange& range);
+
+        int cellSize;
+
+        std::unordered_map<int64_t, std::vector<GameObject*>> cells;
+        std::unordered_map<GameObject*, CellRange> objectCells;
+};
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,53 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Collects the sprites drawn between begin() and end() and submits them with
+// SDL_RenderGeometry (SDL 2.0.18+), one call per run of sprites sharing a texture.
+// While a batch is active, Texture::render and Text queue into it instead of drawing.
+// Sprites are ordered by layer first, then grouped by texture, so anything that has
+// to stay above something else in a different texture needs a higher layer.
+class SpriteBatch
+{
+    public:
+        SpriteBatch();
+
+        static SpriteBatch* getActive();
+
+        void begin();
+        void end(SDL_Renderer* renderer);
+
+        void setLayer(int layer);
+        int getLayer();
+
+        // Queue a (possibly rotated and flipped) sprite, mirroring SDL_RenderCopyEx
+        void draw( SDL_Texture* texture, int textureWidth, int textureHeight, SDL_Rect* clip, SDL_Rect dest, double angle, SDL_Point* center, SDL_RendererFlip flip, SDL_Color color );
+
+        // Queue a ready-made quad, vertices in top-left, top-right, bottom-right, bottom-left order
+        void drawQuad( SDL_Texture* texture, const SDL_Vertex quad[4] );
+
+        int getDrawCalls();
+
+    private:
+        struct Command
+        {
+            int layer;
+            SDL_Texture* texture;
+            int order;
+            int firstVertex;
+        };
+
+        static SpriteBatch* active;
+
+        int layer = 0;
+        int drawCalls = 0;
+
+        // Kept between frames so a steady frame does not allocate
+        std::vector<Command> commands;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+};
+
+#endif // SPRITE_BATCH_H
@@ -0,0 +1,33 @@
+#ifndef SPRITE_STATES_H
+#define SPRITE_STATES_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+#include <string>
+
+#include "./texture.h"
+
+// A fixed set of preloaded textures where one is active at a time.
+// Switching state is an index change, no file I/O.
+class SpriteStates
+{
+    public:
+        SpriteStates();
+
+        bool addState(SDL_Renderer* renderer, std::string path);
+
+        void setState(int index);
+        int getState();
+
+        int getStateAmount();
+
+        Texture& getTexture();
+        Texture& getTexture(int index);
+
+    private:
+        std::vector<Texture> textures;
+
+        int state;
+};
+
+#endif // SPRITE_STATES_H
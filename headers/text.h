@@ -4,11 +4,17 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include "ui_object.h"
+#include "glyph_atlas.h"
+#include "font_cache.h"
 
 class Text : public UIObject
 {
     public:
         Text(std::string content, int x, int y);
+        Text(const Text& other);
+        ~Text();
+
+        Text& operator=(const Text& other);
 
         bool loadFont(std::string path, int size);
 
@@ -20,10 +26,27 @@ class Text : public UIObject
 
         std::string getContent();
 
+        void render(SDL_Renderer* renderer) override
+        {
+            if(useAtlas)
+            {
+                atlas->render( content, getPosition().getX(), getPosition().getY(), color, renderer );
+            }
+            else
+            {
+                UIObject::render(renderer);
+            }
+        }
+
         SDL_Color color;
     private:
-        TTF_Font* font;
+        TTF_Font* getFont();
+
+        FontCache::Entry* fontEntry;
         std::string content;
+
+        GlyphAtlas* atlas = NULL;
+        bool useAtlas = false;
 };
 
-#endif // TEXT_H
\ No newline at end of file
+#endif // TEXT_H
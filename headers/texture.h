@@ -5,13 +5,51 @@
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL.h>
 #include <string>
+#include <memory>
 
+#include "./texture_cache.h"
+#include "./sprite_batch.h"
+#include "./texture_atlas.h"
+
+// Shared ownership of an SDL texture, copies are cheap and the texture is
+// destroyed (or handed back to the TextureCache) when the last one goes away.
+class SharedTexture
+{
+	public:
+		SharedTexture();
+
+		// Takes over the reference TextureCache::acquire handed out
+		explicit SharedTexture( TextureCache::Entry* entry );
+
+		// Takes ownership of a texture nothing else destroys
+		explicit SharedTexture( SDL_Texture* texture );
+
+		SDL_Texture* get() const;
+		long getUseCount() const;
+
+		void reset();
+
+	private:
+		std::shared_ptr<SDL_Texture> texture;
+};
+
+// Move-only, so a texture is never destroyed twice or copied by accident.
+// Use share() where two objects really should draw the same image.
 class Texture
 {
 	public:
 		Texture();
+		Texture( Texture&& other ) noexcept;
 		~Texture();
 
+		Texture( const Texture& other ) = delete;
+		Texture& operator=( const Texture& other ) = delete;
+
+		Texture& operator=( Texture&& other ) noexcept;
+
+		// A new Texture drawing the same image with the same size and modulation
+		Texture share() const;
+
 		bool loadFromFile( std::string path, SDL_Renderer* gRenderer );
 		
 		#if defined(SDL_TTF_MAJOR_VERSION)
@@ -34,11 +72,35 @@ class Texture
 		void setWidth(int w);
 		void setHeight(int h);
 
+		// For callers that build their own geometry: the SDL texture and the
+		// normalized coordinates of clip (the whole image when NULL) inside it
+		SDL_Texture* getSDLTexture();
+		SDL_FRect getTextureCoords( SDL_Rect* clip = NULL );
+
 	private:
 		SDL_Texture* texture;
 
+		// Keeps texture alive, empty for atlas regions since the atlas owns its pages
+		SharedTexture shared;
+
 		int width;
 		int height;
+
+		// Set when the texture is a region of a page in the active TextureAtlas, which owns the page
+		bool hasRegion;
+		SDL_Rect region;
+
+		// Size of the SDL texture itself, width and height may be overridden to scale it
+		int sourceWidth;
+		int sourceHeight;
+
+		// Modulation is kept per Texture and applied on render, since cached SDL textures are shared
+		Uint8 red = 0xFF;
+		Uint8 green = 0xFF;
+		Uint8 blue = 0xFF;
+		Uint8 alpha = 0xFF;
+		SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+		bool hasBlendMode = false;
 };
 
 #endif // TEXTURE_H
\ No newline at end of file
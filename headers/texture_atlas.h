@@ -0,0 +1,57 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+#include <map>
+
+// Packs many small images into a few large pages so sprites can share one texture.
+// Packing only needs SDL_image, which lets it run offline (see atlas_packer.cpp) and
+// save the pages next to a manifest; the game then loads that or packs at startup.
+// While an atlas is active, Texture::loadFromFile resolves packed paths to regions in it.
+class TextureAtlas
+{
+    public:
+        struct Region
+        {
+            int page = 0;
+            SDL_Rect rect = { 0, 0, 0, 0 };
+        };
+
+        TextureAtlas();
+        ~TextureAtlas();
+
+        static TextureAtlas* getActive();
+        static void setActive(TextureAtlas* atlas);
+
+        bool pack(std::vector<std::string> paths, int pageSize);
+
+        bool save(std::string prefix);
+        bool load(std::string prefix);
+
+        bool upload(SDL_Renderer* renderer);
+
+        bool findRegion(std::string path, SDL_Texture*& page, SDL_Rect& rect, int& pageWidth, int& pageHeight);
+
+        int getPageAmount();
+        int getRegionAmount();
+
+        void free();
+
+    private:
+        static std::string normalizePath(std::string path);
+
+        static const int PADDING = 2;
+
+        static TextureAtlas* active;
+
+        std::map<std::string, Region> regions;
+
+        int pageSize = 0;
+        std::vector<SDL_Surface*> pageSurfaces;
+        std::vector<SDL_Texture*> pageTextures;
+};
+
+#endif // TEXTURE_ATLAS_H
@@ -0,0 +1,37 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <unordered_map>
+
+// Shares one SDL_Texture per image path between every Texture that loads it.
+// Entries are reference counted and destroyed as soon as the last user frees them.
+class TextureCache
+{
+    public:
+        struct Entry
+        {
+            std::string path;
+            SDL_Texture* texture = NULL;
+            int width = 0;
+            int height = 0;
+            int refCount = 0;
+        };
+
+        static TextureCache& get();
+
+        // Each acquire is paired with one release, SharedTexture does both
+        Entry* acquire(std::string path, SDL_Renderer* renderer);
+        void release(Entry* entry);
+
+        int getSize();
+
+    private:
+        TextureCache();
+
+        std::unordered_map<std::string, Entry> entries;
+};
+
+#endif // TEXTURE_CACHE_H
@@ -2,13 +2,17 @@
 #define TILEMAP_H
 
 #include <SDL2/SDL.h>
-#include "./tile.h"
+#include "./texture.h"
+#include "./sprite_batch.h"
+#include "./map_file.h"
+#include "./utils/constants.h"
 
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
 #include <ctime>
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -29,34 +33,81 @@ enum class TileType {
     AMOUNT
 };
 
+// Tile IDs stored in CHUNK_SIZE x CHUNK_SIZE chunks, so maps can be any size.
+// Rendering skips chunks outside the camera and reuses each chunk's vertices
+// until one of its tiles changes. Binary maps stay memory mapped and a chunk
+// only copies its tiles out of the file the first time it is used.
 class TileMap
 {
     public:
+        static const int CHUNK_SIZE = 32;
+
         TileMap();
 
+        // Loads a text .map or, by extension, a binary map (see MapFile)
         bool setTiles(std::string mapPath);
+        bool loadBinary(std::string mapPath);
+
         void saveTilesToFile(std::string name);
+        bool saveBinary(std::string name);
 
 		void render( SDL_Rect& camera, SDL_Renderer* renderer );
 
         bool loadTexture( SDL_Renderer* renderer, std::string path );
 
+        // Resizing clears every tile to DIRT
+        void resize(int width, int height);
         void deleteTiles();
 
         Texture& getTexture();
-        Tile** getTiles();
 
-        void setTile(int index, Tile* t);
-        int getTileFromScreenPosition(int x, int y);
+        // Sizes are in tiles
+        int getWidth();
+        int getHeight();
+        int getTilesetId();
+
+        Uint8 getTile(int x, int y);
+        void setTile(int x, int y, Uint8 type);
+
+        // x and y are relative to the screen, camera is where it shows the level
+        int getTileFromScreenPosition(int x, int y, const SDL_Rect& camera);
+
+        // Collision queries read a per-chunk solidity bitmap, only the tiles under the box are checked
+        static bool isSolidType(Uint8 type);
+        bool isSolid(int x, int y);
+        bool overlapsSolid(SDL_Rect box);
 
     private:
-	    static const int TOTAL_TILE_TYPES   = (int)TileType::AMOUNT;
-        static const int TOTAL_TILES        = 20 /* WIDTH OF MAP */ * 15 /* HEIGHT OF MAP */;   // TODO: Hardcoded values
-        static const int TOTAL_PIXEL_WIDTH  = 20 * TILE_WIDTH; 
-        
-        Tile*    tiles[ TOTAL_TILES ];
+        struct Chunk
+        {
+            std::vector<Uint8> tiles; // Empty until the chunk is first used
+            std::vector<SDL_Vertex> vertices; // World space quads, four per tile
+            Uint32 solidRows[ CHUNK_SIZE ] = {}; // Bit x of row y is set when that tile is solid
+            bool dirty = true;
+        };
+
+	    static const int TOTAL_TILE_TYPES = (int)TileType::AMOUNT;
+
+        Chunk& getChunk(int tileX, int tileY);
+        void loadChunk(Chunk& chunk, int chunkX, int chunkY);
+        void setSize(int width, int height);
+        Uint8 toTileType(Uint8 id);
+        void buildGeometry(int chunkX, int chunkY);
+
+        int width = 0;
+        int height = 0;
+        int chunksX = 0;
+        int chunksY = 0;
+        std::vector<Chunk> chunks;
+
+        int tilesetId = 0;
+        MapFile mapFile;
+        const Uint8* source = NULL; // Tiles of the mapped file, row by row
+
         SDL_Rect clips[ TOTAL_TILE_TYPES ];
         Texture sheetTexture;
+        SpriteBatch batch;
+        SDL_Vertex quad[4];
 };
 
-#endif // TILEMAP_H
\ No newline at end of file
+#endif // TILEMAP_H
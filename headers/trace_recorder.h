@@ -0,0 +1,71 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Records Chrome Trace Event JSON (chrome://tracing, ui.perfetto.dev).
+// Events go into a preallocated buffer; full buffers are handed to a writer
+// thread so formatting and disk I/O never happen on the frame being measured.
+class TraceRecorder
+{
+    public:
+        static constexpr int BUFFER_EVENTS = 8192;
+        static constexpr int DETAIL_LENGTH = 96;
+
+        static TraceRecorder& get();
+
+        bool start(std::string path);
+        void stop();
+        bool isRecording();
+
+        // Ticks are SDL_GetPerformanceCounter values, names must outlive the recording
+        void recordSlice(const char* name, Uint64 beginTicks, Uint64 endTicks);
+        void recordInstant(const char* category, const char* name, const char* detail = NULL);
+
+        // Events lost because both buffers were full
+        int getDroppedEvents();
+
+    private:
+        TraceRecorder();
+
+        struct Event
+        {
+            const char* name;
+            const char* category;
+            char phase;
+            double timestamp; // Microseconds since start()
+            double duration;
+            char detail[DETAIL_LENGTH];
+        };
+
+        void push(const Event& event);
+        bool flush(bool wait);
+        void writerLoop();
+        void writeEvent(const Event& event);
+        double toMicroseconds(Uint64 ticks);
+
+        std::vector<Event> front;
+        std::vector<Event> back;
+        int frontCount = 0;
+        int backCount = 0;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::thread writer;
+        bool backPending = false;
+        bool stopping = false;
+
+        FILE* file = NULL;
+        bool firstEvent = true;
+        bool recording = false;
+        Uint64 startTicks = 0;
+        int droppedEvents = 0;
+};
+
+#endif // TRACE_RECORDER_H
@@ -10,6 +10,11 @@ class UIObject
 {
 	public:
 		UIObject( int x, int y, int w, int h );
+		virtual ~UIObject() { }
+
+		// Copies draw the same texture through Texture::share
+		UIObject( const UIObject& other );
+		UIObject& operator=( const UIObject& other );
 
 		virtual void setPosition( int x, int y )
         {
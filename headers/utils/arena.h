@@ -0,0 +1,82 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+// Bump allocator for data that all dies together. Allocations are carved out
+// of large blocks and only given back all at once by release() or the
+// destructor, destructors of the objects themselves are the caller's business.
+class Arena
+{
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        Arena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(size_t size, size_t alignment);
+
+        // Frees every block, anything allocated from the arena is gone
+        void release();
+
+        size_t getBlockAmount();
+        size_t getBytesUsed();
+
+    private:
+        void addBlock(size_t minimumSize);
+
+        std::vector<char*> blocks;
+        char* current = nullptr;
+        size_t remaining = 0;
+        size_t blockSize;
+        size_t bytesUsed = 0;
+};
+
+// Standard allocator over an Arena, deallocate does nothing
+template <typename T>
+class ArenaAllocator
+{
+    public:
+        typedef T value_type;
+
+        ArenaAllocator(Arena* arena) : arena(arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.getArena()) {}
+
+        T* allocate(size_t count)
+        {
+            return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_t) {}
+
+        Arena* getArena() const
+        {
+            return arena;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const
+        {
+            return arena == other.getArena();
+        }
+
+        template <typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const
+        {
+            return arena != other.getArena();
+        }
+
+    private:
+        Arena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // ARENA_H
@@ -14,6 +14,15 @@ const int UI_AREA = 256+64;
 const int SCREEN_FPS = 60;
 const int SCREEN_TICK_PER_FRAME = 1000 / SCREEN_FPS;
 
+// Animations show each of their frames for this many SCREEN_FPS frames
+const int ANIMATION_SKIP_FRAMES = 8;
+
+// Game::update always advances by this fixed step, independent of the frame rate
+const int SIMULATION_HZ = 120;
+const float SIMULATION_STEP = 1.0f / SIMULATION_HZ;
+// Never simulate more than this per rendered frame, so a stall can't snowball
+const float MAX_FRAME_TIME = 0.25f;
+
 const int BUTTON_WIDTH = 96;
 const int BUTTON_HEIGHT = 32;
 
@@ -0,0 +1,26 @@
+#ifndef OBB_H
+#define OBB_H
+
+#include "./vector2d.h"
+
+// Oriented bounding box of a rectangle rotated (in degrees, like SDL) around its center
+struct OBB
+{
+public:
+    void set(const Vector2D& position, const Vector2D& size, float rotation);
+
+    Vector2D center;
+    Vector2D axes[2];       // Unit x and y axes of the box
+    float halfExtents[2];   // Half width and half height along those axes
+
+    // Top left, top right, bottom left, bottom right
+    Vector2D corners[4];
+
+    float getProjectedRadius(const Vector2D& axis) const;
+
+    // Separating axis test. On overlap, normal points from other towards this box
+    // and depth is how far this box has to move along it to separate them.
+    bool intersects(const OBB& other, Vector2D& normal, float& depth) const;
+};
+
+#endif // OBB_H
@@ -0,0 +1,40 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+
+// Non-owning view over contiguous elements, a small stand-in for C++20 std::span.
+// Only valid while the container it was made from is alive and not resized.
+template <typename T>
+class Span
+{
+public:
+    Span() {}
+    Span(T* data, size_t size) : first(data), count(size) {}
+
+    template <typename U, typename Allocator>
+    Span(std::vector<U, Allocator>& vector) : first(vector.data()), count(vector.size()) {}
+
+    template <typename U, typename Allocator>
+    Span(const std::vector<U, Allocator>& vector) : first(vector.data()), count(vector.size()) {}
+
+    // A span over a temporary would dangle as soon as the statement ends
+    template <typename U, typename Allocator>
+    Span(std::vector<U, Allocator>&& vector) = delete;
+
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+
+    T& operator[](size_t index) const { return first[index]; }
+
+    T* data() const { return first; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    T* first = nullptr;
+    size_t count = 0;
+};
+
+#endif // SPAN_H
@@ -36,6 +36,8 @@ class Vector2D {
 
         Vector2D getNormalizedVector();
 
+        float dot(const Vector2D& v2) const;
+
     private:
         float x;
         float y;
@@ -0,0 +1,254 @@
+#include <SDL2/SDL.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "./headers/game/house_generator.h"
+
+// Benchmarks house generation over seeded room trees of increasing size, run as
+//     house_benchmark [houses per size]
+// Every size reports throughput, heap allocations per house and p50/p99 latency
+// of the treemap solve, RoomHandler::createRooms and HouseGenerator::generateWalls.
+// Every treemap is also solved by SolveSquarifiedTreemapReference, and the run
+// fails if any rectangle differs from it.
+
+static size_t allocationCount = 0;
+static size_t allocationBytes = 0;
+
+void* operator new(size_t size)
+{
+    allocationCount++;
+    allocationBytes += size;
+
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+const int ROOM_COUNTS[] = { 6, 16, 32, 64, 128, 256 };
+const int DEFAULT_HOUSES_PER_SIZE = 1000;
+
+// Roughly the room size of the game's 600x400 house with six rooms
+const float AREA_PER_ROOM = 200.0f * 200.0f;
+
+struct Stage
+{
+    const char* name;
+    std::vector<double> times; // Microseconds per house
+    size_t allocations = 0;
+};
+
+// Same shape as the game's houses: weighted rooms, some of them areas split into children
+std::vector<RoomId> createRoomTree(int roomCount, std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> sizeDistribution(2, 12);
+    std::uniform_int_distribution<int> childDistribution(2, 4);
+    std::uniform_int_distribution<int> areaDistribution(0, 5);
+
+    std::vector<RoomId> roomTree;
+    roomTree.push_back(RoomId("LivingRoom", sizeDistribution(generator)));
+
+    int rooms = 1;
+    while (rooms < roomCount)
+    {
+        std::string name = "Room" + std::to_string(rooms);
+        int children = std::min(childDistribution(generator), roomCount - rooms);
+
+        if (children >= 2 && areaDistribution(generator) == 0)
+        {
+            std::vector<RoomId> childRooms;
+            for (int i = 0; i < children; i++)
+            {
+                childRooms.push_back(RoomId(name + "_" + std::to_string(i), sizeDistribution(generator)));
+            }
+            roomTree.push_back(RoomId(name, sizeDistribution(generator), childRooms));
+            rooms += children;
+        }
+        else
+        {
+            roomTree.push_back(RoomId(name, sizeDistribution(generator)));
+            rooms++;
+        }
+    }
+
+    std::shuffle(roomTree.begin() + 1, roomTree.end(), generator);
+    return roomTree;
+}
+
+Rectangle getHouseSize(int roomCount)
+{
+    // 3:2 like the game's house
+    float height = std::sqrt(roomCount * AREA_PER_ROOM / 1.5f);
+    return Rectangle{ std::floor(height * 1.5f), std::floor(height) };
+}
+
+double toMicroseconds(Uint64 ticks)
+{
+    return ticks * 1000000.0 / SDL_GetPerformanceFrequency();
+}
+
+double getPercentile(std::vector<double>& times, int percentile)
+{
+    size_t index = (times.size() - 1) * percentile / 100;
+    std::nth_element(times.begin(), times.begin() + index, times.end());
+    return times[index];
+}
+
+bool isSameLayout(const Array<Rectangle>& layout, const Array<Rectangle>& reference)
+{
+    // Bitwise, the layouts must be identical and not just close
+    return layout.size() == reference.size()
+        && memcmp(layout.data(), reference.data(), layout.size() * sizeof(Rectangle)) == 0;
+}
+
+int main( int argc, char* args[] )
+{
+    int housesPerSize = DEFAULT_HOUSES_PER_SIZE;
+    if (argc > 1)
+    {
+        housesPerSize = atoi(args[1]);
+        if (housesPerSize <= 0)
+        {
+            printf( "Usage: %s [houses per size]\n", args[0] );
+            return 1;
+        }
+    }
+
+    printf( "%d houses per size\n\n", housesPerSize );
+    printf( "%6s  %-14s  %12s  %12s  %10s  %10s\n", "rooms", "stage", "houses/s", "allocs/house", "p50 us", "p99 us" );
+
+    int mismatches = 0;
+
+    for (int roomCount : ROOM_COUNTS)
+    {
+        Stage stages[] = { { "treemap" }, { "treemap ref" }, { "createRooms" }, { "generateWalls" } };
+        for (auto& stage : stages)
+        {
+            stage.times.reserve(housesPerSize);
+        }
+
+        Rectangle houseSize = getHouseSize(roomCount);
+        size_t wallCount = 0;
+        size_t leafCount = 0;
+
+        for (int seed = 0; seed < housesPerSize; seed++)
+        {
+            std::mt19937 generator(seed);
+            std::vector<RoomId> roomTree = createRoomTree(roomCount, generator);
+
+            // Doors are placed with rand(), keep them the same between runs
+            srand(seed);
+
+            Array<Number> dataPoints;
+            for (const auto& room : roomTree)
+            {
+                dataPoints.push_back((float)room.size);
+            }
+
+            size_t allocationsBefore = allocationCount;
+            Uint64 start = SDL_GetPerformanceCounter();
+            auto result = SolveSquarifiedTreemap(dataPoints, houseSize);
+            Uint64 end = SDL_GetPerformanceCounter();
+            stages[0].times.push_back(toMicroseconds(end - start));
+            stages[0].allocations += allocationCount - allocationsBefore;
+
+            allocationsBefore = allocationCount;
+            start = SDL_GetPerformanceCounter();
+            auto reference = SolveSquarifiedTreemapReference(dataPoints, houseSize);
+            end = SDL_GetPerformanceCounter();
+            stages[1].times.push_back(toMicroseconds(end - start));
+            stages[1].allocations += allocationCount - allocationsBefore;
+
+            if (!isSameLayout(result, reference))
+            {
+                printf( "Treemap differs from the reference for %d rooms, seed %d\n", roomCount, seed );
+                mismatches++;
+            }
+
+            allocationsBefore = allocationCount;
+            start = SDL_GetPerformanceCounter();
+            game::HouseGenerator house{roomTree, houseSize};
+            end = SDL_GetPerformanceCounter();
+            stages[2].times.push_back(toMicroseconds(end - start));
+            stages[2].allocations += allocationCount - allocationsBefore;
+
+            allocationsBefore = allocationCount;
+            start = SDL_GetPerformanceCounter();
+            std::vector<GameObject*> walls = house.generateWalls();
+            end = SDL_GetPerformanceCounter();
+            stages[3].times.push_back(toMicroseconds(end - start));
+            stages[3].allocations += allocationCount - allocationsBefore;
+
+            for (const auto& room : house.roomHandler->getRooms())
+            {
+                leafCount += !room.roomId.hasChildren;
+            }
+
+            wallCount += walls.size();
+            for (auto* wall : walls)
+            {
+                delete wall;
+            }
+        }
+
+        for (auto& stage : stages)
+        {
+            double total = 0.0;
+            for (double time : stage.times)
+            {
+                total += time;
+            }
+
+            double throughput = total > 0.0 ? housesPerSize * 1000000.0 / total : 0.0;
+            double allocations = (double)stage.allocations / housesPerSize;
+            double p50 = getPercentile(stage.times, 50);
+            double p99 = getPercentile(stage.times, 99);
+
+            printf( "%6d  %-14s  %12.0f  %12.1f  %10.1f  %10.1f\n", roomCount, stage.name, throughput, allocations, p50, p99 );
+        }
+        printf( "%6s  %.1f leaf rooms, %.1f wall segments per house\n\n", "", (double)leafCount / housesPerSize, (double)wallCount / housesPerSize );
+    }
+
+    if (mismatches > 0)
+    {
+        printf( "%d treemaps differ from the reference solver!\n", mismatches );
+        return 1;
+    }
+
+    return 0;
+}
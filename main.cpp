@@ -13,16 +13,19 @@
 #include <random>
 
 #include "./headers/texture.h"
-#include "./headers/particle.h"
+#include "./headers/particle_system.h"
 #include "./headers/player.h"
 #include "./headers/timer.h"
-#include "./headers/tile.h"
 #include "./headers/button.h"
 #include "./headers/tile_map.h"
 #include "./headers/audio_source.h"
 #include "./headers/text.h"
+#include "./headers/font_cache.h"
 #include "./headers/input_field.h"
 #include "./headers/canvas.h"
+#include "./headers/profiler.h"
+#include "./headers/profiler_overlay.h"
+#include "./headers/trace_recorder.h"
 #include "./headers/image.h"
 #include "./headers/ui_panel.h"
 #include "./headers/game_object.h"
@@ -30,16 +33,29 @@
 #include "./headers/physics_object.h"
 #include "./headers/utils/constants.h"
 
+#include "./headers/texture_atlas.h"
+
 #include "./headers/game/game.h"
+#include "./headers/game/headless_driver.h"
+#include "./headers/game/sprite_atlas.h"
 
 bool init();
+bool initHeadless();
+bool loadAtlas();
 bool loadMedia();
 void close();
+void toggleTrace();
+int runHeadless( int steps, unsigned int seed );
+
+// One minute of game time when --headless is given no step count
+const int HEADLESS_DEFAULT_STEPS = SIMULATION_HZ * 60;
 
 SDL_Window*     window 	 = NULL;
 SDL_Renderer*   renderer = NULL;
 
 Canvas canvas;
+ProfilerOverlay profilerOverlay{ 8, 160, "./resources/fonts/bebasneue-regular.ttf", 16 };
+TextureAtlas spriteAtlas;
 game::Game *gameInstance = NULL;
 
 GameObject wall{{32, 32}, {SCREEN_WIDTH-32, 32+16}};
@@ -104,23 +120,99 @@ bool init()
 	return success;
 }
 
+bool initHeadless()
+{
+	bool success = true;
+
+	// No video or audio subsystem, images are only decoded for their sizes
+	if( SDL_Init( 0 ) < 0 )
+	{
+		printf( "SDL could not initialize! SDL Error: %s\n", SDL_GetError() );
+		success = false;
+	}
+	else
+	{
+		int imgFlags = IMG_INIT_PNG;
+		if( !( IMG_Init( imgFlags ) & imgFlags ) )
+		{
+			printf( "SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError() );
+			success = false;
+		}
+
+		if( TTF_Init() == -1 )
+		{
+			printf( "SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError() );
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+bool loadAtlas()
+{
+	// Prefer the pages written by atlas_packer, pack at startup when they are missing
+	if( !spriteAtlas.load( game::SPRITE_ATLAS_PREFIX ) )
+	{
+		spriteAtlas.pack( game::getAtlasSpritePaths(), game::SPRITE_ATLAS_PAGE_SIZE );
+	}
+
+	if( !spriteAtlas.upload( renderer ) )
+	{
+		spriteAtlas.free();
+		return false;
+	}
+
+	TextureAtlas::setActive( &spriteAtlas );
+	return true;
+}
+
 bool loadMedia()
 {
 	bool success = true;
 
-	success = gameInstance->loadMedia();
+	success = gameInstance->loadMedia(canvas);
+
+	canvas.addObj( &profilerOverlay );
 	
 	return success;
 }
 
+void toggleTrace()
+{
+	TraceRecorder& recorder = TraceRecorder::get();
+	if( recorder.isRecording() )
+	{
+		recorder.stop();
+	}
+	else
+	{
+		recorder.start( "./trace_" + std::to_string( SDL_GetTicks() ) + ".json" );
+	}
+}
+
 void close()
 {
-	free(gameInstance);
+	TraceRecorder::get().stop();
 
+	// The canvas holds the game's FPS text, so free it while the game is alive
 	canvas.freeTextures();
 
-	SDL_DestroyRenderer( renderer );
-	SDL_DestroyWindow( window );
+	delete gameInstance;
+
+	TextureAtlas::setActive( NULL );
+	spriteAtlas.free();
+
+	FontCache::get().closeAll();
+
+	if( renderer != NULL )
+	{
+		SDL_DestroyRenderer( renderer );
+	}
+	if( window != NULL )
+	{
+		SDL_DestroyWindow( window );
+	}
 	window = NULL;
 	renderer = NULL;
 
@@ -130,14 +222,63 @@ void close()
 	SDL_Quit();
 }
 
+int runHeadless( int steps, unsigned int seed )
+{
+	if( !initHeadless() )
+	{
+		printf( "Failed to initialize!\n" );
+		return 1;
+	}
+
+	gameInstance = new game::Game( NULL );
+
+	if( !loadMedia() )
+	{
+		printf( "Failed to load media!\n" );
+	}
+
+	// Unpacks, drags and places every box so physics and scoring are exercised
+	game::HeadlessDriver driver( *gameInstance, seed );
+
+	Uint64 startCounter = SDL_GetPerformanceCounter();
+	for( int i = 0; i < steps; i++ )
+	{
+		driver.step();
+	}
+	double elapsed = (double)( SDL_GetPerformanceCounter() - startCounter ) / SDL_GetPerformanceFrequency();
+
+	printf( "Simulated %d steps (%.1f s of game time) in %.3f s, %.0f steps per second\n",
+		steps, steps * SIMULATION_STEP, elapsed, elapsed > 0 ? steps / elapsed : 0.0 );
+	printf( "Seed %u: placed %d furniture, %d boxes left, score %d%s\n",
+		seed, driver.getPlacedAmount(), gameInstance->getBoxAmount(), gameInstance->getScore(),
+		gameInstance->isFurnished() ? ", furnished" : "" );
+
+	close();
+
+	return 0;
+}
+
 int main( int argc, char* args[] )
 {
+	// --headless [steps] [seed] plays the game without a window, GPU or audio
+	if( argc > 1 && std::string( args[1] ) == "--headless" )
+	{
+		int steps = argc > 2 ? atoi( args[2] ) : HEADLESS_DEFAULT_STEPS;
+		unsigned int seed = argc > 3 ? (unsigned int)strtoul( args[3], NULL, 10 ) : 0;
+		return runHeadless( steps, seed );
+	}
+
 	if( !init() )
 	{
 		printf( "Failed to initialize!\n" );
 	}
 	else
 	{
+		if( !loadAtlas() )
+		{
+			printf( "Failed to load sprite atlas, loading sprites separately!\n" );
+		}
+
 		gameInstance = new game::Game(renderer);
 
 		if( !loadMedia() )
@@ -151,7 +292,6 @@ int main( int argc, char* args[] )
 			SDL_Event e;
 
 			Timer fpsTimer;
-			Timer capTimer;
 
 			int currentTile = 0;
 
@@ -164,10 +304,23 @@ int main( int argc, char* args[] )
 
 			SDL_Rect camera = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
 
+			// Rendering runs as fast as vsync allows, the simulation catches up in fixed steps
+			Uint64 previousCounter = SDL_GetPerformanceCounter();
+			double accumulator = 0.0;
+
 			// Game loop
 			while( !quit )
 			{
-				capTimer.start();
+				Profiler::get().beginFrame();
+
+				Uint64 currentCounter = SDL_GetPerformanceCounter();
+				double frameTime = (double)( currentCounter - previousCounter ) / SDL_GetPerformanceFrequency();
+				previousCounter = currentCounter;
+				if( frameTime > MAX_FRAME_TIME )
+				{
+					frameTime = MAX_FRAME_TIME;
+				}
+				accumulator += frameTime;
 
 				float avgFPS = countedFrames / ( fpsTimer.getTicks() / 1000.f );
 				if( avgFPS > 2000000 )
@@ -175,38 +328,59 @@ int main( int argc, char* args[] )
 					avgFPS = 0;
 				}
 
-				while( SDL_PollEvent( &e ) != 0 )
 				{
-					if( e.type == SDL_QUIT )
+					PROFILE_SCOPE( "Poll events" );
+					while( SDL_PollEvent( &e ) != 0 )
 					{
-						quit = true;
+						if( e.type == SDL_QUIT )
+						{
+							quit = true;
+						}
+						// F4 starts and stops writing a Chrome trace
+						else if( e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F4 && e.key.repeat == 0 )
+						{
+							toggleTrace();
+						}
+
+						canvas.handleEvent( &e );
+
+						gameInstance->handleEvent(&e);
 					}
-
-					canvas.handleEvent( &e );
-
-					gameInstance->handleEvent(&e);
 				}
-				gameInstance->update(avgFPS);
 
-				SDL_SetRenderDrawColor( renderer, 0xFF, 0xFF, 0xFF, 0xFF );
-				SDL_RenderClear( renderer );
+				{
+					PROFILE_SCOPE( "Update" );
+					while( accumulator >= SIMULATION_STEP )
+					{
+						gameInstance->update();
+						accumulator -= SIMULATION_STEP;
+					}
+					gameInstance->updateFPS(avgFPS);
+				}
 
-                canvas.render(renderer);
+				{
+					PROFILE_SCOPE( "Render" );
+					SDL_SetRenderDrawColor( renderer, 0xFF, 0xFF, 0xFF, 0xFF );
+					SDL_RenderClear( renderer );
 
-				gameInstance->render();
+					gameInstance->render( accumulator / SIMULATION_STEP );
 
-				/* ISAKS TESTGREJOR
-				wallScene->render(renderer);
-				*/
+					// UI goes on top of the game
+					canvas.render( renderer );
 
-				SDL_RenderPresent( renderer );
+					/* ISAKS TESTGREJOR
+					wallScene->render(renderer);
+					*/
+				}
 
-				++countedFrames;
-				int frameTicks = capTimer.getTicks();
-				if( frameTicks < SCREEN_TICK_PER_FRAME )
 				{
-					SDL_Delay( SCREEN_TICK_PER_FRAME - frameTicks );
+					PROFILE_SCOPE( "Present" );
+					SDL_RenderPresent( renderer );
 				}
+
+				Profiler::get().endFrame();
+
+				++countedFrames;
 			}
             
 			SDL_StopTextInput();
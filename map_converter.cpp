@@ -0,0 +1,45 @@
+#include <SDL2/SDL.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "./headers/map_file.h"
+#include "./headers/tile_map.h"
+
+// Converts text .map files into the binary map format read by TileMap::loadBinary.
+// Usage: map_converter <input.map> [output.bmap] [tileset id]
+int main( int argc, char* args[] )
+{
+	if( argc < 2 )
+	{
+		printf( "Usage: %s <input.map> [output%s] [tileset id]\n", args[0], MAP_FILE_EXTENSION.c_str() );
+		return 1;
+	}
+
+	std::string input = args[1];
+	std::string output = input.substr( 0, input.rfind( '.' ) ) + MAP_FILE_EXTENSION;
+	if( argc > 2 )
+	{
+		output = args[2];
+	}
+	int tilesetId = argc > 3 ? atoi( args[3] ) : 0;
+
+	int width = 0;
+	int height = 0;
+	std::vector<Uint8> tiles;
+	if( !MapFile::readText( input, (int)TileType::AMOUNT, width, height, tiles ) )
+	{
+		printf( "Failed to read %s!\n", input.c_str() );
+		return 1;
+	}
+
+	if( !MapFile::write( output, width, height, tilesetId, tiles ) )
+	{
+		printf( "Failed to write %s!\n", output.c_str() );
+		return 1;
+	}
+
+	printf( "Converted %s (%dx%d) to %s\n", input.c_str(), width, height, output.c_str() );
+	return 0;
+}
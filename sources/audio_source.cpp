@@ -1,15 +1,18 @@
 #include "../headers/audio_source.h"
+#include "../headers/trace_recorder.h"
 
 AudioSource::AudioSource() { }
 
 void AudioSource::addSound(std::string path)
 {
+    TraceRecorder::get().recordInstant("asset", "Load sound", path.c_str());
     Mix_Chunk* sound = Mix_LoadWAV(path.c_str());
     this->sounds.push_back(sound);
 }
 
 void AudioSource::addMusic(std::string path)
 {
+    TraceRecorder::get().recordInstant("asset", "Load music", path.c_str());
     Mix_Music* music = Mix_LoadMUS(path.c_str());
     this->music.push_back(music);
 }
@@ -40,6 +40,11 @@ void Canvas::addObj(UIObject* obj)
     objs.push_back(obj);
 }
 
+Span<UIObject* const> Canvas::getObjs() const
+{
+    return objs;
+}
+
 void Canvas::setActive(bool state)
 {
     isActive = state;
@@ -82,7 +82,7 @@ void Explorer::render(SDL_Renderer* renderer)   // TODO: This function should be
             text->loadTexture(renderer);
 
             UIStateObject* uiStateObj = new UIStateObject{0, 0, 32, 32};
-            uiStateObj->getTexture() = folderTexture;
+            uiStateObj->getTexture() = folderTexture.share();
 
             uiStateObj->addSpriteClip( { 0, 0, 32, 32 } );
             uiStateObj->addSpriteClip( { 0, 32, 32, 32 } );
@@ -104,7 +104,7 @@ void Explorer::render(SDL_Renderer* renderer)   // TODO: This function should be
             text->loadTexture(renderer);
 
             UIStateObject* uiStateObj = new UIStateObject{0, 0, 32, 32};
-            uiStateObj->getTexture() = fileTexture;
+            uiStateObj->getTexture() = fileTexture.share();
 
             uiStateObj->addSpriteClip( { 0, 0, 32, 32 } );
             uiStateObj->addSpriteClip( { 0, 32, 32, 32 } );
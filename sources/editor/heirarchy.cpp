@@ -22,8 +22,7 @@ void Heirarchy::setActiveScene(Scene* scene, SDL_Renderer* renderer)
     activeScene = scene;
     index = 0;
 
-    std::vector<GameObject*> objs = activeScene->getObjs();
-    for (auto* obj: objs)
+    for (auto* obj: activeScene->getObjs())
     {
         UIPanel* textPanel = new UIPanel{0, 0, panel.getSize().getX(), 28};
         
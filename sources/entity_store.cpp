@@ -0,0 +1,257 @@
+#include "../headers/entity_store.h"
+#include "../headers/utils/constants.h"
+#include <cassert>
+#include <cmath>
+
+EntityStore::EntityStore()
+{
+
+}
+
+EntityStore& EntityStore::get()
+{
+    // Never destroyed, so global GameObjects can still remove themselves on exit
+    static EntityStore* instance = new EntityStore();
+    return *instance;
+}
+
+void EntityStore::create(Entity entity)
+{
+    Uint32 slot;
+
+    if (freeSlots.empty())
+    {
+        slot = slotAmount++;
+    }
+    else
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    slots[entity] = slot;
+    transforms.add(slot);
+    motions.add(slot);
+    sprites.add(slot);
+}
+
+void EntityStore::destroy(Entity entity)
+{
+    auto it = slots.find(entity);
+
+    if (it == slots.end())
+    {
+        return;
+    }
+
+    Uint32 slot = it->second;
+    transforms.remove(slot);
+    motions.remove(slot);
+    sprites.remove(slot);
+    bodies.remove(slot);
+
+    freeSlots.push_back(slot);
+    slots.erase(it);
+}
+
+void EntityStore::copy(Entity from, Entity to)
+{
+    Uint32 fromSlot = getSlot(from);
+    Uint32 toSlot = getSlot(to);
+
+    transforms.get(toSlot) = transforms.get(fromSlot);
+    motions.get(toSlot) = motions.get(fromSlot);
+
+    Sprite& sprite = sprites.get(toSlot);
+    sprite.texture = sprites.get(fromSlot).texture.share();
+    sprite.texturePath = sprites.get(fromSlot).texturePath;
+
+    if (bodies.has(fromSlot))
+    {
+        bodies.add(toSlot) = bodies.get(fromSlot);
+    }
+}
+
+Uint32 EntityStore::getSlot(Entity entity)
+{
+    auto it = slots.find(entity);
+    assert(it != slots.end() && "entity was destroyed or never created");
+    return it->second;
+}
+
+Transform& EntityStore::getTransform(Entity entity)
+{
+    return transforms.get(getSlot(entity));
+}
+
+Motion& EntityStore::getMotion(Entity entity)
+{
+    return motions.get(getSlot(entity));
+}
+
+Sprite& EntityStore::getSprite(Entity entity)
+{
+    return sprites.get(getSlot(entity));
+}
+
+PhysicsBody& EntityStore::addBody(Entity entity)
+{
+    return bodies.add(getSlot(entity));
+}
+
+PhysicsBody& EntityStore::getBody(Entity entity)
+{
+    return bodies.get(getSlot(entity));
+}
+
+bool EntityStore::hasBody(Entity entity)
+{
+    auto it = slots.find(entity);
+    return it != slots.end() && bodies.has(it->second);
+}
+
+int EntityStore::getSize()
+{
+    return slots.size();
+}
+
+void EntityStore::storePreviousStates()
+{
+    for (Uint32 slot = 0; slot < bodies.getSlotAmount(); slot++)
+    {
+        if (!bodies.has(slot) || !bodies.get(slot).simulated)
+        {
+            continue;
+        }
+
+        Transform& transform = transforms.get(slot);
+        transform.previousPosition = transform.position;
+        transform.previousRotation = transform.rotation;
+        transform.hasPreviousState = true;
+    }
+}
+
+void EntityStore::stepBodies(float deltaTime)
+{
+    for (Uint32 slot = 0; slot < bodies.getSlotAmount(); slot++)
+    {
+        if (!bodies.has(slot) || !bodies.get(slot).simulated)
+        {
+            continue;
+        }
+
+        Transform& transform = transforms.get(slot);
+        Motion& motion = motions.get(slot);
+        moveBody(transform, motion, bodies.get(slot), deltaTime);
+        rotateBody(transform, motion, deltaTime);
+    }
+}
+
+void EntityStore::moveBody(Transform& transform, Motion& motion, PhysicsBody& body, float deltaTime)
+{
+    float frames = deltaTime * SCREEN_FPS;
+    Vector2D& velocity = motion.velocity;
+
+    if (body.hasFriction)
+    {
+        float velSqrMagnitude = velocity.getX()*velocity.getX() + velocity.getY()*velocity.getY();
+        bool isNotMoving = velSqrMagnitude <= 1; // TODO: decide better value
+
+        if (isNotMoving)
+        {
+            body.acceleration.setX(-velocity.getX());
+            body.acceleration.setY(-velocity.getY());
+            velocity.increaseX(body.acceleration.getX());
+            velocity.increaseY(body.acceleration.getY());
+        }
+        else
+        {
+            float fricCoefficient = 0.0025f * body.mass; // TODO: decide better value
+            float fricMagnitude = fricCoefficient * 9.82f;
+
+            Vector2D fricDirection = velocity.getNormalizedVector() * -1;
+            Vector2D friction = fricDirection * (fricMagnitude * frames);
+            body.acceleration.set(friction.getX(), friction.getY());
+
+            velocity.increaseX(body.acceleration.getX());
+            velocity.increaseY(body.acceleration.getY());
+        }
+    }
+
+    Vector2D newPosition = transform.position + velocity * frames;
+    Vector2D& size = transform.size;
+
+    if (newPosition.getX() <= 0)
+    {
+        float magnitude = abs(velocity.getX());
+        velocity.setX(magnitude);
+        float distToBound = 0 - newPosition.getX();
+        newPosition.increaseX(distToBound);
+    }
+    else if (newPosition.getX() >= SCREEN_WIDTH - size.getX())
+    {
+        float magnitude = abs(velocity.getX());
+        velocity.setX(-magnitude);
+        float distToBound = newPosition.getX() + size.getX() - SCREEN_WIDTH;
+        newPosition.decreaseX(distToBound);
+    }
+
+    if (newPosition.getY() <= 0)
+    {
+        float magnitude = abs(velocity.getY());
+        velocity.setY(magnitude);
+        float distToBound = 0 - newPosition.getY();
+        newPosition.increaseY(distToBound);
+    }
+    else if (newPosition.getY() >= SCREEN_HEIGHT - size.getY())
+    {
+        float magnitude = abs(velocity.getY());
+        velocity.setY(-magnitude);
+        float distToBound = newPosition.getY() + size.getY() - SCREEN_HEIGHT;
+        newPosition.decreaseY(distToBound);
+    }
+
+    transform.position = newPosition;
+
+    if (velocity.getX() <= 0.1 && velocity.getX() >= -0.1)
+    {
+        velocity.setX(0);
+    }
+
+    if (velocity.getY() <= 0.1 && velocity.getY() >= -0.1)
+    {
+        velocity.setY(0);
+    }
+}
+
+void EntityStore::rotateBody(Transform& transform, Motion& motion, float deltaTime)
+{
+    if (motion.rotationDirection == RotDir::NONE)
+    {
+        return;
+    }
+
+    float frames = deltaTime * SCREEN_FPS;
+    float localVel = motion.rotationSpeed*motion.rotationSpeed;
+    float friction = localVel * 0.0025 * frames;
+
+    motion.rotationSpeed -= friction;
+
+    if (motion.rotationSpeed <= 0.25 && motion.rotationSpeed >= -0.25)
+    {
+        motion.rotationSpeed = 0;
+        motion.rotationDirection = RotDir::NONE;
+    }
+
+    switch (motion.rotationDirection)
+    {
+        case RotDir::RIGHT:
+            transform.rotation = fmod(transform.rotation + motion.rotationSpeed * frames, 360.0);
+        break;
+        case RotDir::LEFT:
+            transform.rotation = fmod(transform.rotation - motion.rotationSpeed * frames, 360.0);
+        break;
+        case RotDir::NONE:
+        break;
+    }
+}
@@ -0,0 +1,85 @@
+#include "../headers/font_cache.h"
+#include "../headers/trace_recorder.h"
+#include <iostream>
+
+FontCache::FontCache() { }
+
+FontCache& FontCache::get()
+{
+    // Never destroyed, so global Texts can still release during static teardown
+    static FontCache* instance = new FontCache();
+    return *instance;
+}
+
+FontCache::Entry* FontCache::acquire(std::string path, int size)
+{
+    auto key = std::make_pair(path, size);
+
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        it->second.refCount++;
+        return &it->second;
+    }
+
+    TraceRecorder::get().recordInstant("asset", "Load font", path.c_str());
+
+    TTF_Font* font = TTF_OpenFont( path.c_str(), size );
+    if( font == NULL )
+    {
+        printf( "Unable to load font %s! SDL_ttf Error: %s\n", path.c_str(), TTF_GetError() );
+        return NULL;
+    }
+
+    Entry& entry = entries[key];
+    entry.path = path;
+    entry.size = size;
+    entry.font = font;
+    entry.refCount = 1;
+
+    return &entry;
+}
+
+void FontCache::retain(Entry* entry)
+{
+    if (entry != NULL)
+    {
+        entry->refCount++;
+    }
+}
+
+void FontCache::release(Entry* entry)
+{
+    if (entry == NULL)
+    {
+        return;
+    }
+
+    entry->refCount--;
+    if (entry->refCount <= 0)
+    {
+        if (entry->font != NULL)
+        {
+            TTF_CloseFont( entry->font );
+        }
+        auto key = std::make_pair(entry->path, entry->size);
+        entries.erase(key);
+    }
+}
+
+void FontCache::closeAll()
+{
+    for (auto& [key, entry] : entries)
+    {
+        if (entry.font != NULL)
+        {
+            TTF_CloseFont( entry.font );
+            entry.font = NULL;
+        }
+    }
+}
+
+int FontCache::getSize()
+{
+    return entries.size();
+}
@@ -6,20 +6,35 @@ namespace game
 {
     Cursor::Cursor(std::string name) : GameObject({SCREEN_WIDTH, SCREEN_HEIGHT}, {32, 32}, {0, 0}, name, "./resources/hand-point.png") {}
 
-    void Cursor::updateTexture(SDL_Renderer *renderer)
+    void Cursor::loadStates(SDL_Renderer *renderer)
     {
+        // Same order as HandState
+        states.addState(renderer, "./resources/hand-point.png");
+        states.addState(renderer, "./resources/hand.png");
+        states.addState(renderer, "./resources/hand-closed.png");
+
+        getSize().set(states.getTexture().getWidth(), states.getTexture().getHeight());
+        statesApplied = false;
+        updateTexture();
+    }
+
+    void Cursor::updateTexture()
+    {
+        HandState state = HAND_POINT;
         if (isClosed)
         {
-            setTexturePath("./resources/hand-closed.png");
+            state = HAND_CLOSED;
         }
         else if (isHovering)
         {
-            setTexturePath("./resources/hand.png");
+            state = HAND_OPEN;
         }
-        else
+
+        if (!statesApplied || states.getState() != state)
         {
-            setTexturePath("./resources/hand-point.png");
+            states.setState(state);
+            getTexture() = states.getTexture().share();
+            statesApplied = true;
         }
-        loadTexture(renderer);
     }
 }
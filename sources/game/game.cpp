@@ -9,6 +9,8 @@
 
 #include "../../headers/game_object.h"
 #include "../../headers/scene.h"
+#include "../../headers/profiler.h"
+#include "../../headers/trace_recorder.h"
 #include "../../headers/utils/constants.h"
 
 #include "../../headers/game/house_generator.h"
@@ -17,6 +19,23 @@
 // General TODO: Discuss what should give and remove points
 // as well as decide on how many points.
 
+// Draw order of the sprite batch, see SpriteBatch
+enum RenderLayer
+{
+    LAYER_BACKGROUND,
+    LAYER_FLOOR,
+    LAYER_ROOM_NAME, // Room::render draws names one layer above LAYER_FLOOR
+    LAYER_WALLS,
+    LAYER_BOXES,
+    LAYER_FURNITURE,
+    LAYER_CHECKPOINTS,
+    LAYER_HAROLD,
+    LAYER_HUD,
+    LAYER_SCOREBOARD,
+    LAYER_SCOREBOARD_TEXT,
+    LAYER_CURSOR
+};
+
 static Vector2D getMousePos()
 {
     int mouseX, mouseY;
@@ -28,12 +47,16 @@ namespace game
 {
     Game::Game(SDL_Renderer *renderer)
         : renderer(renderer)
+        , headless(renderer == nullptr)
         , cursor(Cursor("Cursor"))
         , fpsText({"", 0, 96})
     {
-        audioSource.addMusic( "./resources/Gamejam.wav" );
-        audioSource.addSound( "./resources/scratch.wav" );
-        audioSource.addSound( "./resources/high.wav"    );
+        if (!headless)
+        {
+            audioSource.addMusic( "./resources/Gamejam.wav" );
+            audioSource.addSound( "./resources/scratch.wav" );
+            audioSource.addSound( "./resources/high.wav"    );
+        }
 
         scoreText       = new Text{ "Score:0",                                                              0,                48                 };
         tutorialText    = new Text{ "Press [E] to place furniture. Use [Mouse Wheel] to rotate furniture.", SCREEN_WIDTH / 2, SCREEN_HEIGHT - 28 };
@@ -45,6 +68,8 @@ namespace game
         HouseGenerator houseGenerator{};
         rooms = houseGenerator.generateRooms();
         walls = houseGenerator.generateWalls();
+        for (auto* wall : walls)
+            collisionGrid.insert(wall);
 
         FurnitureLoader loader{};
         loader.loadFurnitureData("./resources/furniture/furniture_meta_data.txt");
@@ -56,16 +81,32 @@ namespace game
 
     Game::~Game()
     {
-        free(harold);
+        delete harold;
 
+        // Boxes don't own their furniture
         for (auto box : boxes)
-            free(box);
+        {
+            delete box->furniture;
+            delete box;
+        }
         if (currFurn != nullptr)
-            free(currFurn);
+            delete currFurn;
         for (auto furn : placedFurn)
-            free(furn);
-        
-        //free(roomScene); TODO: rooms
+            delete furn;
+
+        for (auto room : rooms)
+            delete room;
+        for (auto wall : walls)
+            delete wall;
+        for (auto checkpoint : checkpoints)
+            delete checkpoint;
+
+        delete scoreText;
+        delete tutorialText;
+        delete placedFurnText;
+        delete currentFurnText;
+        for (auto highscore : highscores)
+            delete highscore;
     }
 
     bool Game::loadMedia(Canvas &canvas)
@@ -101,7 +142,8 @@ namespace game
         
         canvas.addObj(&fpsText);
 
-        cursor.loadTexture(renderer);
+        cursor.loadStates(renderer);
+        harold->loadStates(renderer);
 
         for (auto box : boxes)
         {
@@ -109,7 +151,7 @@ namespace game
             box->furniture->loadTexture(renderer);
         }
 
-        if( Mix_PlayingMusic() == 0 )
+        if( !headless && Mix_PlayingMusic() == 0 )
 		{
 			Mix_PlayMusic( audioSource.getMusic(0), -1 );
 		}
@@ -117,47 +159,80 @@ namespace game
         return success;
     }
 
-    void Game::render()
+    bool Game::isHeadless()
+    {
+        return headless;
+    }
+
+    void Game::playSound(int index)
+    {
+        if (!headless)
+        {
+            if (TraceRecorder::get().isRecording())
+                TraceRecorder::get().recordInstant("audio", "Mix_PlayChannel", std::to_string(index).c_str());
+            Mix_PlayChannel( -1, audioSource.getSound(index), 0 );
+        }
+    }
+
+    void Game::render(float alpha)
     {
+        PROFILE_SCOPE("Game::render");
+
+        if (headless)
+            return;
+
+        batch.begin();
+
         if (!gameStarted)
         {
+            batch.setLayer(LAYER_BACKGROUND);
             mainMenuBackground.render(renderer);
         }
         else
         {
+            batch.setLayer(LAYER_BACKGROUND);
             background.render(renderer);
 
+            batch.setLayer(LAYER_FLOOR);
             for (auto* room : rooms)
             {
                 room->render(renderer);
             }
 
+            batch.setLayer(LAYER_WALLS);
             for (auto* wall : walls)
             {
                 wall->render(renderer);
             }
 
+            batch.setLayer(LAYER_BOXES);
             for (auto box : boxes)
                 box->render(renderer);
             
+            batch.setLayer(LAYER_FURNITURE);
             if (currFurn != nullptr) 
             {
-                currFurn->render(renderer);
-                currentFurnText->render(renderer);
+                currFurn->render(renderer, alpha);
             }
             
             for (auto furniture : placedFurn)
-                furniture->render(renderer);
+                furniture->render(renderer, alpha);
 
+            batch.setLayer(LAYER_CHECKPOINTS);
             for (auto* checkpoint : checkpoints)
             {
                 checkpoint->render(renderer);
             }
 
-            harold->updateTexture(renderer);
-            harold->render(renderer);
+            batch.setLayer(LAYER_HAROLD);
+            harold->updateTexture();
+            harold->render(renderer, alpha);
 
-            fpsText.render(renderer); // TODO: disable on release
+            batch.setLayer(LAYER_HUD);
+            if (currFurn != nullptr)
+            {
+                currentFurnText->render(renderer);
+            }
             scoreText->render(renderer);
             placedFurnText->render(renderer);
             tutorialText->render(renderer);
@@ -165,8 +240,10 @@ namespace game
 
         if(gameOver)
         {
+            batch.setLayer(LAYER_SCOREBOARD);
             highscoreBackground.render(renderer);
 
+            batch.setLayer(LAYER_SCOREBOARD_TEXT);
             for(auto* highscore : highscores)
             {
                 highscore->render(renderer);
@@ -174,8 +251,11 @@ namespace game
             // TODO: Implement reset function and add 'Play Again' button.
         }
 
-        cursor.updateTexture(renderer);
+        batch.setLayer(LAYER_CURSOR);
+        cursor.updateTexture();
         cursor.render(renderer);
+
+        batch.end(renderer);
     }
 
     void Game::placeFurn()
@@ -204,20 +284,20 @@ namespace game
                 {
                     score += 10;
                     activeRoom->setColor(0, 255, 0);
-                    Mix_PlayChannel( -1, audioSource.getSound(1), 0 );
+                    playSound(1);
                 }
                 else
                 {
                     score -= 10;
                     activeRoom->setColor(255, 0, 0);
-                    Mix_PlayChannel( -1, audioSource.getSound(0), 0 );
+                    playSound(0);
                 }
             }
             else
             {
                 score -= 10;
                 // TODO: flash background red?
-                Mix_PlayChannel( -1, audioSource.getSound(0), 0 );
+                playSound(0);
             }
 
             scoreText->updateContent("Score:" + std::to_string(score));
@@ -252,11 +332,88 @@ namespace game
             }
 
             currFurn = nullptr;
+            hasDragTarget = false;
         }
     }
 
+    void Game::unpack(Box *box)
+    {
+        auto i = std::find(boxes.begin(), boxes.end(), box);
+        if (i == boxes.end())
+            return;
+
+        boxes.erase(i);
+        currFurn = box->furniture;
+        currFurn->setSimulated(true);
+
+        Vector2D furnPos = box->getPosition() + box->getSize() / 2 - currFurn->getSize() / 2;
+        currFurn->setPosition(furnPos);
+        collisionGrid.insert(currFurn);
+
+        delete box;
+    }
+
+    int Game::getBoxAmount()
+    {
+        return boxes.size();
+    }
+
+    bool Game::unpackBox(int index)
+    {
+        if (currFurn || index < 0 || index >= boxes.size())
+            return false;
+
+        unpack(boxes[index]);
+        return true;
+    }
+
+    Furniture* Game::getCurrentFurniture()
+    {
+        return currFurn;
+    }
+
+    void Game::dragFurniture(Vector2D target)
+    {
+        if (!currFurn)
+            return;
+
+        currFurn->isDragging = true;
+        hasDragTarget = true;
+        dragTarget = target;
+    }
+
+    void Game::releaseFurniture()
+    {
+        if (currFurn)
+            currFurn->isDragging = false;
+        hasDragTarget = false;
+    }
+
+    void Game::placeFurniture()
+    {
+        releaseFurniture();
+        placeFurn();
+    }
+
+    const std::vector<Room*>& Game::getRooms()
+    {
+        return rooms;
+    }
+
+    int Game::getScore()
+    {
+        return score;
+    }
+
+    bool Game::isFurnished()
+    {
+        return furnished;
+    }
+
     void Game::handleEvent(SDL_Event *event)
     {
+        PROFILE_SCOPE("Game::handleEvent");
+
         Box *clickedBox = nullptr;
 
         for (auto box : boxes)
@@ -307,21 +464,7 @@ namespace game
 
         if (clickedBox)
         {
-            for (auto i = boxes.begin(); i != boxes.end(); i++)
-            {
-                Box *box = *i;
-                if (box == clickedBox)
-                {
-                    boxes.erase(i);
-                    currFurn = box->furniture;
-
-                    Vector2D furnPos = box->getPosition() + box->getSize() / 2 - currFurn->getSize() / 2;
-                    currFurn->setPosition(furnPos);
-
-                    free(box);
-                    break;
-                }
-            }
+            unpack(clickedBox);
         }
 
         harold->handleEvent(event);
@@ -345,7 +488,7 @@ namespace game
         }
     }
 
-    void Game::update(float avgFPS)
+    void Game::updateFPS(float avgFPS)
     {
         std::stringstream fpsTextStream;
         fpsTextStream.str("");
@@ -353,6 +496,16 @@ namespace game
 
         fpsText.updateContent(fpsTextStream.str());
         fpsText.loadTexture(renderer);
+    }
+
+    void Game::update()
+    {
+        PROFILE_SCOPE("Game::update");
+
+        // Unpacked and placed furniture are the simulated bodies
+        EntityStore& entities = EntityStore::get();
+        entities.storePreviousStates();
+        harold->storePreviousState();
 
         if (currFurn)
         {
@@ -374,39 +527,34 @@ namespace game
             }
         }
 
-        Vector2D mousePos = getMousePos();
+        Vector2D mousePos = hasDragTarget ? dragTarget : getMousePos();
         if (currFurn && currFurn->isDragging)
         {
             Vector2D moveDir = mousePos - currFurn->getPosition();
 
-            float deltaTime = 1 / avgFPS; // TODO: pass in as parameter instead?
+            // Velocity is per 60 Hz frame, so pull by a frame's worth whatever the step
+            float frameTime = 1.0f / SCREEN_FPS;
             float pullSpeed = 20 / currFurn->getMass(); // TODO: finjustera
-            currFurn->setVelocity(moveDir * deltaTime * pullSpeed);
+            currFurn->setVelocity(moveDir * frameTime * pullSpeed);
         }
 
+        // Integrate every body first, then resolve contacts against the moved positions
+        entities.stepBodies(SIMULATION_STEP);
+
+        if (currFurn)
+            collisionGrid.update(currFurn);
+        for (auto furn : placedFurn)
+            collisionGrid.update(furn);
+
         if (currFurn)
         {
-            currFurn->move();
-            currFurn->rotate();
-            std::vector<GameObject *> others;
-            for (auto furn : placedFurn)
-                others.push_back(furn);
-            currFurn->handleCollisions(others);
-            currFurn->handleCollisions(walls);
+            collisionGrid.query(currFurn, collisionCandidates);
+            currFurn->handleCollisions(collisionCandidates);
         }
         for (auto furn : placedFurn)
         {
-            furn->move();
-            furn->rotate();
-            std::vector<GameObject *> others;
-            for (auto otherFurn : placedFurn)
-                if (furn != otherFurn)
-                    others.push_back(furn);
-
-            if (currFurn)
-                others.push_back(currFurn);
-            furn->handleCollisions(others);
-            furn->handleCollisions(walls);
+            collisionGrid.query(furn, collisionCandidates);
+            furn->handleCollisions(collisionCandidates);
         }
 
         if (currFurn && currFurn->isDragging)
@@ -417,7 +565,7 @@ namespace game
         else
             cursor.setPosition(mousePos - cursor.getSize() / 2);
 
-        harold->move();
+        harold->move(SIMULATION_STEP);
 
         if (!gameOver && furnished)
         {
@@ -454,6 +602,8 @@ namespace game
                     count++;
                 }
 
+                for (auto* highscore : highscores)
+                    delete highscore;
                 highscores.clear();
                 int offset = 0;
                 for (const auto& l : lines) {
@@ -481,6 +631,7 @@ namespace game
                 }
                 if(indexToRemove >= 0)
                 {
+                    delete checkpoints[indexToRemove];
                     checkpoints.erase(checkpoints.begin() + indexToRemove);
                 }
             }
@@ -1,4 +1,6 @@
 #include "../../headers/game/harold.h"
+#include "../../headers/utils/constants.h"
+#include <cmath>
 
 namespace game
 {
@@ -8,10 +10,42 @@ namespace game
         // TODO: init walk and idle animation
     }
 
-    void Harold::updateTexture(SDL_Renderer *renderer)
+    void Harold::loadStates(SDL_Renderer *renderer)
     {
-        // TODO: change textures if walking or idling
-        loadTexture(renderer);
+        states.addState(renderer, "./resources/harold/haroldstill.png");
+        for (int i = 1; i <= WALK_FRAMES; i++)
+        {
+            states.addState(renderer, "./resources/harold/haroldwalking" + std::to_string(i) + ".png");
+        }
+
+        // The frames are drawn at half resolution
+        for (int i = 0; i < states.getStateAmount(); i++)
+        {
+            Texture& frame = states.getTexture(i);
+            frame.setWidth(frame.getWidth() * SPRITE_SCALE);
+            frame.setHeight(frame.getHeight() * SPRITE_SCALE);
+        }
+
+        getSize().set(states.getTexture().getWidth(), states.getTexture().getHeight());
+        statesApplied = false;
+        updateTexture();
+    }
+
+    void Harold::updateTexture()
+    {
+        int state = IDLE_STATE;
+        if (isMoving())
+        {
+            int walkFrame = (int)(walkTime * SCREEN_FPS) / ANIMATION_SKIP_FRAMES;
+            state = 1 + walkFrame % WALK_FRAMES;
+        }
+
+        if (!statesApplied || states.getState() != state)
+        {
+            states.setState(state);
+            getTexture() = states.getTexture().share();
+            statesApplied = true;
+        }
     }
 
     void Harold::handleEvent(SDL_Event* event)
@@ -38,19 +72,19 @@ namespace game
         {
         case SDLK_w:
             getVelocity().increaseY(-1.0f);
-            rotation = 0;
+            setRotation(0);
             break;
         case SDLK_a:
             getVelocity().increaseX(-1.0f);
-            rotation = 270;
+            setRotation(270);
             break;
         case SDLK_s:
             getVelocity().increaseY(1.0f);
-            rotation = 180;
+            setRotation(180);
             break;
         case SDLK_d:
             getVelocity().increaseX(1.0f);
-            rotation = 90;
+            setRotation(90);
             break;
         }
     }
@@ -78,10 +112,21 @@ namespace game
         }
     }
 
-    void Harold::move()
+    void Harold::move(float deltaTime)
     {
         Vector2D normalVel = getVelocity().getNormalizedVector();
-        getPosition() += normalVel*2;
+        getPosition() += normalVel * (2 * deltaTime * SCREEN_FPS);
+
+        if (isMoving())
+        {
+            // Wrapped at a full walk cycle so the float never loses precision
+            float cycleTime = (float)(WALK_FRAMES * ANIMATION_SKIP_FRAMES) / SCREEN_FPS;
+            walkTime = fmod(walkTime + deltaTime, cycleTime);
+        }
+        else
+        {
+            walkTime = 0.0f;
+        }
     }
 
     void Harold::loadAnimation(SDL_Renderer *renderer)
@@ -96,11 +141,11 @@ namespace game
     {
         if(playAnimation)
         {
-            activeAnimation->render({getPosition().getX(), getPosition().getY()}, renderer, rotation);
+            activeAnimation->render({getPosition().getX(), getPosition().getY()}, renderer, getRotation());
         }
         else
         {
-            idleTexture.render( getPosition().getX(), getPosition().getY(), NULL, rotation, NULL, SDL_FLIP_NONE, renderer);
+            idleTexture.render( getPosition().getX(), getPosition().getY(), NULL, getRotation(), NULL, SDL_FLIP_NONE, renderer);
         }
     }
 
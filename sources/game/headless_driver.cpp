@@ -0,0 +1,90 @@
+#include "../../headers/game/headless_driver.h"
+#include "../../headers/utils/constants.h"
+
+// Chance that furniture is taken to a room it fits in, when there is one
+const float FITTING_ROOM_CHANCE = 0.75f;
+// Furniture is placed once it is this close to its target, once it has come to
+// rest against a wall or short of the target, or after MAX_DRAG_STEPS
+const float PLACE_DISTANCE = 8.0f;
+const int MIN_DRAG_STEPS = SIMULATION_HZ / 4;
+const int MAX_DRAG_STEPS = SIMULATION_HZ * 3;
+
+namespace game
+{
+    HeadlessDriver::HeadlessDriver(Game &game, unsigned int seed)
+        : game(game)
+        , generator(seed)
+    {
+    }
+
+    void HeadlessDriver::step()
+    {
+        Furniture *furniture = game.getCurrentFurniture();
+        if (!furniture)
+        {
+            if (game.getBoxAmount() > 0)
+                unpackNext();
+        }
+        else
+        {
+            Vector2D offset = target - furniture->getPosition();
+            float distanceSqr = offset.getX()*offset.getX() + offset.getY()*offset.getY();
+
+            Vector2D& velocity = furniture->getVelocity();
+            bool isResting = dragSteps >= MIN_DRAG_STEPS && velocity.getX() == 0 && velocity.getY() == 0;
+
+            if (distanceSqr <= PLACE_DISTANCE*PLACE_DISTANCE || isResting || dragSteps >= MAX_DRAG_STEPS)
+            {
+                game.placeFurniture();
+                placedAmount++;
+            }
+            else
+            {
+                game.dragFurniture(target);
+                dragSteps++;
+            }
+        }
+
+        game.update();
+    }
+
+    int HeadlessDriver::getPlacedAmount()
+    {
+        return placedAmount;
+    }
+
+    void HeadlessDriver::unpackNext()
+    {
+        std::uniform_int_distribution<int> boxDistribution(0, game.getBoxAmount() - 1);
+        game.unpackBox(boxDistribution(generator));
+
+        Furniture *furniture = game.getCurrentFurniture();
+        const std::vector<Room*>& rooms = game.getRooms();
+
+        std::vector<Room*> fittingRooms;
+        for (auto* room : rooms)
+        {
+            if (furniture->compatableWith(room->getName()))
+                fittingRooms.push_back(room);
+        }
+
+        std::uniform_real_distribution<float> chanceDistribution(0.0f, 1.0f);
+        bool toFittingRoom = !fittingRooms.empty() && chanceDistribution(generator) < FITTING_ROOM_CHANCE;
+        const std::vector<Room*>& candidates = toFittingRoom ? fittingRooms : rooms;
+
+        dragSteps = 0;
+        if (candidates.empty())
+        {
+            target = furniture->getPosition();
+            return;
+        }
+
+        std::uniform_int_distribution<int> roomDistribution(0, candidates.size() - 1);
+        Room *room = candidates[roomDistribution(generator)];
+
+        // Targets are top left corners, so center the furniture on the room
+        Vector2D roomCenter{room->position.getX() + room->xOffset + room->size.getX() / 2,
+                            room->position.getY() + room->yOffset + room->size.getY() / 2};
+        target = roomCenter - furniture->getSize() / 2;
+    }
+}
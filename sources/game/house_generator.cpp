@@ -1,5 +1,6 @@
 #include "../../headers/game/house_generator.h"
 #include "../../headers/game/room.h"
+#include <utility>
 
 namespace game
 {
@@ -33,7 +34,25 @@ namespace game
             roomOrder.push_back(RoomId("LivingRoom", sizeDistribution2(generator)));
         }
 
-        roomHandler = new RoomHandler{roomOrder, container};
+        generate(std::move(roomOrder));
+    }
+
+    HouseGenerator::HouseGenerator(std::vector<RoomId> roomOrder, Rectangle houseSize) {
+        houseW = (int)houseSize.Width;
+        houseH = (int)houseSize.Height;
+        xOff = screenW/2 - houseW/2;
+        yOff = screenH/2 - houseH/2;
+        container = houseSize;
+
+        generate(std::move(roomOrder));
+    }
+
+    HouseGenerator::~HouseGenerator() {
+        delete roomHandler;
+    }
+
+    void HouseGenerator::generate(std::vector<RoomId> roomOrder) {
+        roomHandler = new RoomHandler{std::move(roomOrder), container};
         roomHandler->createRooms();
 
         dir = roomHandler->dir;
@@ -56,7 +75,7 @@ namespace game
         std::vector<GameObject*> walls;
         for(const auto& wall : roomHandler->walls)
         {
-            for(const auto& lineSegment : wall.lineSegments)
+            for(const auto& lineSegment : wall.getLineSegments())
             {
                 walls.push_back(genWall(static_cast<int>(floor(lineSegment.startX)), static_cast<int>(floor(lineSegment.startY)), static_cast<int>(floor(lineSegment.endX)), static_cast<int>(floor(lineSegment.endY)), xOff, yOff, wallThickness));
             }
@@ -1,4 +1,5 @@
 #include "../../headers/game/room.h"
+#include "../../headers/sprite_batch.h"
 
 namespace game
 {
@@ -16,6 +17,12 @@ namespace game
         nameText = new Text{name, x+xOffset+8, y+yOffset+8};
     }
 
+    Room::~Room()
+    {
+        delete floorImage;
+        delete nameText;
+    }
+
     bool Room::isInside(int x, int y)
     {
         bool xInBound = x >= position.getX()+xOffset && x <= position.getX()+xOffset + size.getX();
@@ -63,7 +70,20 @@ namespace game
                 blue+=3;
             }
         }
-        nameText->render(renderer);
+
+        // Names go above the floors of every room, which share the batch layer
+        SpriteBatch* batch = SpriteBatch::getActive();
+        if (batch != nullptr)
+        {
+            int layer = batch->getLayer();
+            batch->setLayer(layer + 1);
+            nameText->render(renderer);
+            batch->setLayer(layer);
+        }
+        else
+        {
+            nameText->render(renderer);
+        }
     }
 
     std::string Room::getName()
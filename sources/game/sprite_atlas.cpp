@@ -0,0 +1,47 @@
+#include "../../headers/game/sprite_atlas.h"
+
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+
+namespace game
+{
+    std::vector<std::string> getAtlasSpritePaths()
+    {
+        std::vector<std::string> paths = {
+            "./resources/box.png",
+            "./resources/ring.png",
+            "./resources/hand.png",
+            "./resources/hand-point.png",
+            "./resources/hand-closed.png",
+            "./resources/debug.png",
+            "./resources/floor.png",
+            "./resources/kitchen-floor.png",
+            "./resources/bathroom-floor.png",
+            "./resources/harold/haroldstill.png",
+            "./resources/harold/haroldwalking1.png",
+            "./resources/harold/haroldwalking2.png",
+            "./resources/harold/haroldwalking3.png",
+            "./resources/harold/haroldwalking4.png"
+        };
+
+        std::vector<std::string> furniture;
+        try {
+            for (const auto& entry : std::filesystem::directory_iterator("./resources/furniture/"))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".png")
+                {
+                    furniture.push_back("./resources/furniture/" + entry.path().filename().string());
+                }
+            }
+        } catch (const std::filesystem::filesystem_error& ex) {
+            std::cerr << "Error: " << ex.what() << "\n";
+        }
+
+        // Directory order is unspecified, keep the packed layout stable between runs
+        std::sort(furniture.begin(), furniture.end());
+        paths.insert(paths.end(), furniture.begin(), furniture.end());
+
+        return paths;
+    }
+}
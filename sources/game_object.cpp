@@ -1,163 +1,174 @@
 #include "../headers/game_object.h"
+#include "../headers/name_table.h"
 
 #include <iostream>
 #include <string>
-#include <random>
+#include <utility>
 
-std::string getRandomName(int length) {
-    static const std::string charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    std::string result;
-    std::random_device rd;
-    std::mt19937 generator(rd());
-    std::uniform_int_distribution<int> distribution(0, charset.size() - 1);
+// Ids are never reused, 0 is left free to mean no object
+static Uint32 nextId = 1;
 
-    for (int i = 0; i < length; ++i) {
-        result += charset[distribution(generator)];
-    }
-
-    return result;
+GameObject::GameObject()
+{
+    id = nextId++;
+    EntityStore::get().create(id);
 }
 
-GameObject::GameObject()
+GameObject::GameObject(int x, int y, int w, int h)
 {
-    name = getRandomName(8);
+    id = nextId++;
+    EntityStore::get().create(id);
 
-    position.setX(0);
-    position.setY(0);
+    Transform& transform = getTransform();
+    transform.position.set(x, y);
+    transform.size.set(w, h);
+}
 
-    velocity.setX(0);
-    velocity.setY(0);
+GameObject::GameObject(Vector2D topLeft, Vector2D bottomRight)
+{
+    id = nextId++;
+    EntityStore::get().create(id);
 
-    size.setX(0);
-    size.setY(0);
+    Transform& transform = getTransform();
+    transform.position = topLeft;
+    transform.size.setX(bottomRight.getX()-topLeft.getX());
+    transform.size.setY(bottomRight.getY()-topLeft.getY());
+
+    getSprite().texturePath = "./resources/black.png";
+    isStatic = true;
 }
 
-GameObject::GameObject(int x, int y, int w, int h)
+GameObject::GameObject(Vector2D pos, Vector2D s, Vector2D vel, std::string n, std::string path)
 {
-    name = getRandomName(8);
+    id = nextId++;
+    nameId = NameTable::get().intern(n);
+    EntityStore::get().create(id);
 
-    position.setX(x);
-    position.setY(y);
+    Transform& transform = getTransform();
+    transform.position = pos;
+    transform.size = s;
+    getMotion().velocity = vel;
+    getSprite().texturePath = path;
+}
 
-    velocity.setX(0);
-    velocity.setY(0);
+GameObject::GameObject(const GameObject& other)
+{
+    // A copy is a new entity with the same components
+    id = nextId++;
+    EntityStore::get().create(id);
+    *this = other;
+}
 
-    size.setX(w);
-    size.setY(h);
+GameObject::~GameObject()
+{
+    EntityStore::get().destroy(id);
 }
 
-GameObject::GameObject(Vector2D topLeft, Vector2D bottomRight)
+GameObject& GameObject::operator=(const GameObject& other)
 {
-    name = getRandomName(8);
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    EntityStore::get().copy(other.id, id);
 
-    position.setX(topLeft.getX());
-    position.setY(topLeft.getY());
+    debugMode = other.debugMode;
+    isStatic = other.isStatic;
+    obbValid = false;
+    debugTexture = other.debugTexture.share();
+    currentState = other.currentState;
+    toggle = other.toggle;
+    nameId = other.nameId;
 
-    velocity.setX(0);
-    velocity.setY(0);
+    return *this;
+}
 
-    size.setX(bottomRight.getX()-topLeft.getX());
-    size.setY(bottomRight.getY()-topLeft.getY());
+Transform& GameObject::getTransform()
+{
+    return EntityStore::get().getTransform(id);
+}
 
-    texturePath = "./resources/black.png";
-    isStatic = true;
+Motion& GameObject::getMotion()
+{
+    return EntityStore::get().getMotion(id);
 }
 
-GameObject::GameObject(Vector2D pos, Vector2D s, Vector2D vel, std::string n, std::string path)
+Sprite& GameObject::getSprite()
 {
-    position = pos;
-    size = s;
-    velocity = vel;
-    name = n;
-    texturePath = path;
+    return EntityStore::get().getSprite(id);
 }
 
 Vector2D& GameObject::getPosition()
 {
-    return position;
+    return getTransform().position;
 }
 
 Vector2D& GameObject::getVelocity()
 {
-    return velocity;
+    return getMotion().velocity;
 }
 
 Vector2D& GameObject::getSize()
 {
-    return size;
+    return getTransform().size;
 }
 
-void GameObject::setTexture(Texture texture)
+void GameObject::setTexture(Texture&& texture)
 {
-    this->texture = texture;
+    getSprite().texture = std::move(texture);
 }
 
 void GameObject::setPosition(Vector2D position)
 {
-    this->position = position;
+    getTransform().position = position;
 }
 
 void GameObject::setVelocity(Vector2D velocity)
 {
-    this->velocity = velocity;
+    getMotion().velocity = velocity;
 }
 
 void GameObject::setSize(Vector2D size)
 {
-    this->size = size;
+    getTransform().size = size;
 }
 
 SDL_Rect GameObject::toBox()
 {
+    Vector2D& position = getPosition();
+    Vector2D& size = getSize();
     SDL_Rect box = { position.getX(), position.getY(), size.getX(), size.getY() };
     return box;
 }
 
-std::vector<Vector2D> GameObject::getCorners()
+const OBB& GameObject::getOBB()
 {
-    std::vector<Vector2D> corners;
-
-    float halfWidth = size.getX() / 2;
-    float halfHeight = size.getY() / 2;
-
-    float radians = rotation * (M_PI / 180.0);
-    float cosine = std::cos(radians);
-    float sine = std::sin(radians);
-
-    float xOffset = position.getX() + halfWidth;
-    float yOffset = position.getY() + halfHeight;
-
-    Vector2D topLeft{
-        cosine * (-halfWidth) - sine * (-halfHeight) + xOffset,
-        cosine * (-halfHeight) + sine * (-halfWidth) + yOffset
-    };
-
-    Vector2D topRight{
-        cosine * (halfWidth) - sine * (-halfHeight) + xOffset,
-        cosine * (-halfHeight) + sine * (halfWidth) + yOffset
-    };
+    const Transform& transform = getTransform();
+    const Vector2D& position = transform.position;
+    const Vector2D& size = transform.size;
+    float rotation = transform.rotation;
 
-    Vector2D bottomLeft{
-        cosine * (-halfWidth) - sine * (halfHeight) + xOffset,
-        cosine * (halfHeight) + sine * (-halfWidth) + yOffset
-    };
+    bool changed = !obbValid
+        || position.getX() != obbPosition.getX() || position.getY() != obbPosition.getY()
+        || size.getX() != obbSize.getX() || size.getY() != obbSize.getY()
+        || rotation != obbRotation;
 
-    Vector2D bottomRight{
-        cosine * (halfWidth) - sine * (halfHeight) + xOffset,
-        cosine * (halfHeight) + sine * (halfWidth) + yOffset
-    };
-
-    corners.push_back(topLeft);
-    corners.push_back(topRight);
-    corners.push_back(bottomLeft);
-    corners.push_back(bottomRight);
+    if (changed)
+    {
+        obb.set(position, size, rotation);
+        obbPosition = position;
+        obbSize = size;
+        obbRotation = rotation;
+        obbValid = true;
+    }
 
-    return corners;
+    return obb;
 }
 
 Texture& GameObject::getTexture()
 {
-    return texture;
+    return getSprite().texture;
 }
 
 bool GameObject::hasCollision(GameObject* other)
@@ -200,50 +211,18 @@ bool GameObject::hasCollision(GameObject* other)
     return true;
 }
 
-bool GameObject::hasCollision(std::vector<Vector2D> otherCorners)
+bool GameObject::hasCollision(GameObject* other, Vector2D& normal, float& depth)
 {
-    std::vector<Vector2D> corners = getCorners();
-    
-    Vector2D offset = getPosition() + getSize() / 2;
-
-    // Apply offset and rotation to this object's corners
-    for (int idx = 0; idx < 4; idx++)
-    {
-        corners[idx] -= offset;
-        float rotatedX = corners[idx].getX() * cos(rotation) - corners[idx].getY() * sin(rotation);
-        float rotatedY = corners[idx].getX() * sin(rotation) + corners[idx].getY() * cos(rotation);
-        corners[idx] = {rotatedX, rotatedY};
-        corners[idx] += offset; // Apply offset back
-    }
-
-    // Apply offset and rotation to other object's corners
-    for (int idx = 0; idx < 4; idx++)
-    {
-        otherCorners[idx] -= offset;
-        float rotatedX = otherCorners[idx].getX() * cos(rotation) - otherCorners[idx].getY() * sin(rotation);
-        float rotatedY = otherCorners[idx].getX() * sin(rotation) + otherCorners[idx].getY() * cos(rotation);
-        otherCorners[idx] = {rotatedX, rotatedY};
-        otherCorners[idx] += offset; // Apply offset back
-    }
-
-    // Check for overlap
-    if ((corners[0].getX() < otherCorners[1].getX() && corners[1].getX() > otherCorners[0].getX()) &&
-        (corners[0].getY() < otherCorners[3].getY() && corners[3].getY() > otherCorners[0].getY()))
-    {
-        return true; // Collision detected
-    }
-
-    return false; // No collision
+    return getOBB().intersects(other->getOBB(), normal, depth);
 }
 
-
 bool GameObject::loadTexture(SDL_Renderer* renderer, std::string path)
 {
+    Texture& texture = getTexture();
     bool loaded = texture.loadFromFile(path, renderer);
     if(!isStatic)
     {
-        size.setX(texture.getWidth());
-        size.setY(texture.getHeight());
+        getSize().set(texture.getWidth(), texture.getHeight());
     }
     return loaded;
 }
@@ -252,41 +231,104 @@ bool GameObject::loadTexture(SDL_Renderer* renderer)
 {
     debugTexture.loadFromFile("./resources/debug.png", renderer);
 
-    bool loaded = texture.loadFromFile(texturePath, renderer);
+    Sprite& sprite = getSprite();
+    bool loaded = sprite.texture.loadFromFile(sprite.texturePath, renderer);
     if(!isStatic)
     {
-        size.setX(texture.getWidth());
-        size.setY(texture.getHeight());
+        getSize().set(sprite.texture.getWidth(), sprite.texture.getHeight());
     }
     return loaded;
 }
 
 std::string GameObject::getName()
 {
-    return name;
+    if (nameId != NameTable::NO_NAME)
+    {
+        return NameTable::get().getString(nameId);
+    }
+
+    return "Object" + std::to_string(id);
 }
 
-void GameObject::render(SDL_Renderer* renderer)
+Entity GameObject::getId()
 {
+    return id;
+}
+
+bool GameObject::hasName()
+{
+    return nameId != NameTable::NO_NAME;
+}
+
+void GameObject::render(SDL_Renderer* renderer, float alpha)
+{
+    Texture& texture = getTexture();
     if(isStatic)
     {
-        texture.setWidth(size.getX()) ;
-        texture.setHeight(size.getY());
+        texture.setWidth(getSize().getX()) ;
+        texture.setHeight(getSize().getY());
     }
-    texture.render( position.getX(), position.getY(), NULL, rotation, NULL, SDL_FLIP_NONE, renderer );
+    Vector2D renderPosition = getInterpolatedPosition(alpha);
+    texture.render( renderPosition.getX(), renderPosition.getY(), NULL, getInterpolatedRotation(alpha), NULL, SDL_FLIP_NONE, renderer );
 
     if(debugMode)
     {
-        for (auto corner: getCorners())
+        for (auto& corner: getOBB().corners)
         {
             debugTexture.render( corner.getX()-2, corner.getY()-2, NULL, 0.0, NULL, SDL_FLIP_NONE, renderer );
         }
     }
 }
 
+void GameObject::storePreviousState()
+{
+    Transform& transform = getTransform();
+    transform.previousPosition = transform.position;
+    transform.previousRotation = transform.rotation;
+    transform.hasPreviousState = true;
+}
+
+Vector2D GameObject::getInterpolatedPosition(float alpha)
+{
+    const Transform& transform = getTransform();
+
+    // Objects that are never stepped just render where they are
+    if(!transform.hasPreviousState)
+    {
+        return transform.position;
+    }
+    return transform.previousPosition + (transform.position - transform.previousPosition) * alpha;
+}
+
+float GameObject::getInterpolatedRotation(float alpha)
+{
+    const Transform& transform = getTransform();
+    if(!transform.hasPreviousState)
+    {
+        return transform.rotation;
+    }
+
+    // Take the short way around when the rotation wrapped at +-360
+    float difference = fmod(transform.rotation - transform.previousRotation, 360.0);
+    if(difference > 180.0f)
+    {
+        difference -= 360.0f;
+    }
+    else if(difference < -180.0f)
+    {
+        difference += 360.0f;
+    }
+    return transform.previousRotation + difference * alpha;
+}
+
 void GameObject::setTexturePath(std::string path)
 {
-    texturePath = path;
+    getSprite().texturePath = path;
+}
+
+std::string GameObject::getTexturePath()
+{
+    return getSprite().texturePath;
 }
 
 bool GameObject::isInside(int x, int y)
@@ -318,21 +360,33 @@ State GameObject::getCurrentState()
 
 void GameObject::setRotation(float value)
 {
-    rotation = value;
+    getTransform().rotation = value;
+}
+
+float GameObject::getRotation()
+{
+    return getTransform().rotation;
 }
 
 void GameObject::increaseRotation(float amount)
 {
+    float& rotation = getTransform().rotation;
     rotation+=amount;
     rotation = fmod(rotation, 360.0);
 }
 
 void GameObject::decreaseRotation(float amount)
 {
+    float& rotation = getTransform().rotation;
     rotation-=amount;
     rotation = fmod(rotation, 360.0);
 }
 
+bool GameObject::isStaticObject()
+{
+    return isStatic;
+}
+
 bool GameObject::isMoving()
 {
     return (getVelocity().getX() != 0 || getVelocity().getY() != 0);
@@ -340,10 +394,10 @@ bool GameObject::isMoving()
 
 void GameObject::setRotationDirection(RotDir dir)
 {
-    rotationDirection = dir;
+    getMotion().rotationDirection = dir;
 }
 
 void GameObject::setRotationSpeed(float speed)
 {
-    rotationSpeed = speed;
+    getMotion().rotationSpeed = speed;
 }
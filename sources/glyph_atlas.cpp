@@ -0,0 +1,229 @@
+#include "../headers/glyph_atlas.h"
+#include "../headers/sprite_batch.h"
+#include <iostream>
+
+GlyphAtlas::GlyphAtlas() { }
+
+GlyphAtlas* GlyphAtlas::get(std::string path, int size)
+{
+    static std::map<std::pair<std::string, int>, GlyphAtlas*> atlases;
+
+    GlyphAtlas*& atlas = atlases[ std::make_pair(path, size) ];
+    if (atlas == NULL)
+    {
+        atlas = new GlyphAtlas();
+    }
+    return atlas;
+}
+
+bool GlyphAtlas::isBuilt()
+{
+    return texture != NULL;
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font)
+{
+    if (isBuilt())
+    {
+        return true;
+    }
+    if (font == NULL)
+    {
+        return false;
+    }
+
+    // Rasterize in white, the text color is applied per vertex
+    SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+    SDL_Surface* glyphSurfaces[ GLYPH_AMOUNT ] = { NULL };
+
+    // Shelf packing, one row per line height
+    int x = 0;
+    int y = 0;
+    int rowHeight = 0;
+    for (int i = 0; i < GLYPH_AMOUNT; i++)
+    {
+        Uint16 ch = FIRST_GLYPH + i;
+
+        int advance = 0;
+        TTF_GlyphMetrics( font, ch, NULL, NULL, NULL, NULL, &advance );
+        glyphs[i].advance = advance;
+
+        glyphSurfaces[i] = TTF_RenderGlyph_Solid( font, ch, white );
+        if (glyphSurfaces[i] == NULL)
+        {
+            continue;
+        }
+
+        int w = glyphSurfaces[i]->w;
+        int h = glyphSurfaces[i]->h;
+        if (x + w > ATLAS_WIDTH)
+        {
+            x = 0;
+            y += rowHeight + GLYPH_PADDING;
+            rowHeight = 0;
+        }
+
+        glyphs[i].clip = { x, y, w, h };
+        x += w + GLYPH_PADDING;
+        if (h > rowHeight)
+        {
+            rowHeight = h;
+        }
+    }
+
+    width = ATLAS_WIDTH;
+    height = y + rowHeight;
+    lineHeight = TTF_FontHeight( font );
+
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat( 0, width, height, 32, SDL_PIXELFORMAT_RGBA32 );
+    if (atlasSurface == NULL)
+    {
+        printf( "Unable to create glyph atlas surface! SDL Error: %s\n", SDL_GetError() );
+    }
+    else
+    {
+        SDL_FillRect( atlasSurface, NULL, SDL_MapRGBA( atlasSurface->format, 0, 0, 0, 0 ) );
+        for (int i = 0; i < GLYPH_AMOUNT; i++)
+        {
+            if (glyphSurfaces[i] != NULL)
+            {
+                SDL_BlitSurface( glyphSurfaces[i], NULL, atlasSurface, &glyphs[i].clip );
+            }
+        }
+
+        texture = SDL_CreateTextureFromSurface( renderer, atlasSurface );
+        if (texture == NULL)
+        {
+            printf( "Unable to create glyph atlas texture! SDL Error: %s\n", SDL_GetError() );
+        }
+        else
+        {
+            SDL_SetTextureBlendMode( texture, SDL_BLENDMODE_BLEND );
+        }
+
+        SDL_FreeSurface( atlasSurface );
+    }
+
+    for (int i = 0; i < GLYPH_AMOUNT; i++)
+    {
+        if (glyphSurfaces[i] != NULL)
+        {
+            SDL_FreeSurface( glyphSurfaces[i] );
+        }
+    }
+
+    return texture != NULL;
+}
+
+bool GlyphAtlas::canRender(const std::string& content)
+{
+    for (char c : content)
+    {
+        unsigned char ch = (unsigned char)c;
+        if (ch < FIRST_GLYPH || ch > LAST_GLYPH)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GlyphAtlas::render(const std::string& content, int x, int y, SDL_Color color, SDL_Renderer* renderer)
+{
+    if (!isBuilt())
+    {
+        return;
+    }
+
+    // Solid text rendering never honoured a zero alpha, e.g. colors given as { r, g, b }
+    if (color.a == 0)
+    {
+        color.a = 0xFF;
+    }
+
+    SpriteBatch* batch = SpriteBatch::getActive();
+
+    vertices.clear();
+    indices.clear();
+
+    float penX = x;
+    for (char c : content)
+    {
+        // Content may change after Text chose the atlas, skip what it can't draw like getWidth
+        unsigned char ch = (unsigned char)c;
+        if (ch < FIRST_GLYPH || ch > LAST_GLYPH)
+        {
+            continue;
+        }
+
+        Glyph& glyph = glyphs[ ch - FIRST_GLYPH ];
+        const SDL_Rect& clip = glyph.clip;
+
+        if (clip.w > 0 && clip.h > 0)
+        {
+            float u0 = (float)clip.x / width;
+            float v0 = (float)clip.y / height;
+            float u1 = (float)(clip.x + clip.w) / width;
+            float v1 = (float)(clip.y + clip.h) / height;
+
+            SDL_Vertex quad[4] = {
+                { { penX,          (float)y          }, color, { u0, v0 } },
+                { { penX + clip.w, (float)y          }, color, { u1, v0 } },
+                { { penX + clip.w, (float)y + clip.h }, color, { u1, v1 } },
+                { { penX,          (float)y + clip.h }, color, { u0, v1 } }
+            };
+
+            if (batch != NULL)
+            {
+                batch->drawQuad(texture, quad);
+            }
+            else
+            {
+                int first = vertices.size();
+                vertices.insert(vertices.end(), quad, quad + 4);
+
+                indices.push_back(first);
+                indices.push_back(first + 1);
+                indices.push_back(first + 2);
+                indices.push_back(first);
+                indices.push_back(first + 2);
+                indices.push_back(first + 3);
+            }
+        }
+
+        penX += glyph.advance;
+    }
+
+    if (!indices.empty())
+    {
+        SDL_RenderGeometry( renderer, texture, vertices.data(), vertices.size(), indices.data(), indices.size() );
+    }
+}
+
+int GlyphAtlas::getWidth(const std::string& content)
+{
+    int w = 0;
+    for (char c : content)
+    {
+        unsigned char ch = (unsigned char)c;
+        if (ch >= FIRST_GLYPH && ch <= LAST_GLYPH)
+        {
+            w += glyphs[ ch - FIRST_GLYPH ].advance;
+        }
+    }
+    return w;
+}
+
+int GlyphAtlas::getHeight()
+{
+    return lineHeight;
+}
+
+void GlyphAtlas::free()
+{
+    if (texture != NULL)
+    {
+        SDL_DestroyTexture( texture );
+        texture = NULL;
+    }
+}
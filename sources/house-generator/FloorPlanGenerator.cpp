@@ -27,7 +27,7 @@ int main()
 
     for(const auto& wall : roomHandler.walls)
     {
-        for(const auto& lineSegment : wall.lineSegments)
+        for(const auto& lineSegment : wall.getLineSegments())
         {
             std::cout << "Start(" << lineSegment.startX << "," << lineSegment.startY << ")" << std::endl;
             std::cout << "End(" << lineSegment.endX << "," << lineSegment.endY << ")" << std::endl;
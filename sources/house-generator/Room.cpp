@@ -41,23 +41,29 @@ Wall::Wall(float startX, float startY, float endX, float endY, bool hasDoor)
 	generateLineSegments();
 }
 
+Span<const LineSegment> Wall::getLineSegments() const
+{
+	return Span<const LineSegment>(lineSegments, lineSegmentCount);
+}
+
 void Wall::generateLineSegments()
 {
+	lineSegmentCount = 0;
 	if (hasDoor && doorSuccess) {
 		float center = calculateDoorLocation();
 
 		//float center = length() / 2;
 		if (isHorizontal) {
-			lineSegments.emplace_back(LineSegment(startX, startY, startX + center - doorSize / 2, endY));
-			lineSegments.emplace_back(LineSegment(startX + center + doorSize / 2, startY, endX, endY));
+			lineSegments[lineSegmentCount++] = LineSegment(startX, startY, startX + center - doorSize / 2, endY);
+			lineSegments[lineSegmentCount++] = LineSegment(startX + center + doorSize / 2, startY, endX, endY);
 		}
 		else {
-			lineSegments.emplace_back(LineSegment(startX, startY, endX, startY + center - doorSize / 2));
-			lineSegments.emplace_back(LineSegment(startX, startY + center + doorSize / 2, endX, endY));
+			lineSegments[lineSegmentCount++] = LineSegment(startX, startY, endX, startY + center - doorSize / 2);
+			lineSegments[lineSegmentCount++] = LineSegment(startX, startY + center + doorSize / 2, endX, endY);
 		}
 	}
 	else {
-		lineSegments.emplace_back(LineSegment(startX, startY, endX, endY));
+		lineSegments[lineSegmentCount++] = LineSegment(startX, startY, endX, endY);
 	}
 }
 
@@ -107,33 +113,16 @@ bool RoomId::operator==(const RoomId& other) const
 
 // ------------------ GeneratedRoom 
 
-GeneratedRoom::GeneratedRoom(float x, float y, float width, float height, RoomId roomId)
+GeneratedRoom::GeneratedRoom(float x, float y, float width, float height, const RoomId& roomId)
 {
 	this->x = x;
 	this->y = y;
 	this->width = width;
 	this->height = height;
-	this->roomId = roomId;
-}
-
-void GeneratedRoom::addNeighbor(GeneratedRoom& neighbor)
-{
-	neighbors.emplace_back(neighbor);
-}
-
-std::vector<GeneratedRoom> GeneratedRoom::getNeighbors() const
-{
-	return neighbors;
-}
-
-void GeneratedRoom::addConnectedNeighbor(const GeneratedRoom& neighbor)
-{
-	connectedNeighbors.emplace_back(neighbor);
-}
-
-std::vector<GeneratedRoom> GeneratedRoom::getConnectedNeighbors() const
-{
-	return connectedNeighbors;
+	this->roomId.name = roomId.name;
+	this->roomId.size = roomId.size;
+	this->roomId.hasChildren = roomId.hasChildren;
+	this->roomId.area = roomId.area;
 }
 
 std::ostream& operator<<(std::ostream& os, const GeneratedRoom& room)
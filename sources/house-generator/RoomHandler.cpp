@@ -1,18 +1,57 @@
 #include "../../headers/house-generator/RoomHandler.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
 
-RoomHandler::RoomHandler(std::vector<RoomId> roomTree, Rectangle houseSize) {
-	this->roomTree = roomTree;
+static size_t countNodes(const std::vector<RoomId>& nodes) {
+	size_t count = nodes.size();
+	for (const auto& node : nodes) {
+		count += countNodes(node.children);
+	}
+	return count;
+}
+
+RoomHandler::RoomHandler(std::vector<RoomId> roomTree, Rectangle houseSize)
+	: walls(&arena), rooms(&arena), areas(&arena), edges(&arena),
+	  neighborOffsets(&arena), neighbors(&arena), connectedOffsets(&arena), connectedNeighbors(&arena) {
+	this->roomTree = std::move(roomTree);
 	this->houseSize = houseSize;
 }
 
 void RoomHandler::createRooms() {
-	processNodes(this->roomTree, {});
+	// Growing an arena vector leaves the old buffer behind, so size up front
+	this->rooms.reserve(countNodes(this->roomTree));
+	size_t roomCapacity = this->rooms.capacity();
+
+	ArenaVector<RoomId*> roots(&arena);
+	roots.reserve(this->roomTree.size());
+	for (auto& node : this->roomTree) {
+		roots.emplace_back(&node);
+	}
+
+	processNodes(roots, -1);
+	assert(this->rooms.capacity() == roomCapacity);
+
 	findRoomNeighbors();
 	createOuterWalls();
 }
 
+size_t RoomHandler::countOuterWalls() const
+{
+	size_t count = 0;
+	for (const auto& room : this->rooms) {
+		count += (room.x == 0) + (room.x + room.width == houseSize.Width)
+			+ (room.y == 0) + (room.y + room.height == houseSize.Height);
+	}
+	return count;
+}
+
 void RoomHandler::createOuterWalls()
 {
+	// Already reserved when called from createRooms
+	this->walls.reserve(this->walls.size() + countOuterWalls());
+	size_t wallCapacity = this->walls.capacity();
+
 	for (const auto& room : this->rooms) {
 		
 		bool placeDoor = false;
@@ -29,14 +68,15 @@ void RoomHandler::createOuterWalls()
 			continue;
 		}
 		
-		std::vector<uint8_t> validWallNumbers;
+		uint8_t validWallNumbers[4];
+		size_t validWallAmount = 0;
 		for (const auto& num : { hasLeft * 1, hasRight * 2, hasTop * 3, hasBottom * 4 }) {
 			if (num != 0) {
-				validWallNumbers.emplace_back(num);
+				validWallNumbers[validWallAmount++] = num;
 			}
 		}
 		if (isEntranceRoom) {
-			entranceWall = randomWallNumber(validWallNumbers);
+			entranceWall = randomWallNumber(Span<const uint8_t>(validWallNumbers, validWallAmount));
 			if(entranceWall == 1)
 			{
 				dir = "left";
@@ -58,184 +98,252 @@ void RoomHandler::createOuterWalls()
 		// Left wall
 		if (hasLeft) {
 			placeDoor = (entranceWall == 1);
-			this->walls.emplace_back(Wall(room.x, room.y, room.x, room.y + room.height, placeDoor));
+			this->walls.emplace_back(room.x, room.y, room.x, room.y + room.height, placeDoor);
 		}
 		// Right wall 
 		if (hasRight) {
 			placeDoor = (entranceWall == 2);
-			this->walls.emplace_back(Wall(room.x + room.width, room.y, room.x + room.width, room.y + room.height, placeDoor));
+			this->walls.emplace_back(room.x + room.width, room.y, room.x + room.width, room.y + room.height, placeDoor);
 		}
 		// Top wall
 		if (hasTop) {
 			placeDoor = (entranceWall == 3);
-			this->walls.emplace_back(Wall(room.x, room.y, room.x + room.width, room.y, placeDoor));
+			this->walls.emplace_back(room.x, room.y, room.x + room.width, room.y, placeDoor);
 		}
 		// Bottom wall
 		if (hasBottom) {
 			placeDoor = (entranceWall == 4);
-			this->walls.emplace_back(Wall(room.x, room.y + room.height, room.x + room.width, room.y + room.height, placeDoor));
+			this->walls.emplace_back(room.x, room.y + room.height, room.x + room.width, room.y + room.height, placeDoor);
 		}
 	}
+
+	assert(this->walls.capacity() == wallCapacity);
 }
 
-void RoomHandler::processNodes(std::vector<RoomId>& nodes, std::optional<GeneratedRoom> parent)
+void RoomHandler::processNodes(const ArenaVector<RoomId*>& nodes, int parentIndex)
 {
+	// Rooms are referred to by index, processing children appends to this->rooms
 	Rectangle container;
-	if (parent.has_value()) {
-		GeneratedRoom* room = &parent.value();
-		container = Rectangle{ (float)(room->width), (float)(room->height), (float)(room->x), (float)(room->y) };
+	if (parentIndex >= 0) {
+		const GeneratedRoom& room = this->rooms[parentIndex];
+		container = Rectangle{ (float)(room.width), (float)(room.height), (float)(room.x), (float)(room.y) };
 	}
 	else {
 		container = houseSize;
 	}
-	std::vector<std::pair<GeneratedRoom, std::vector<RoomId>>> roomIdsWithChildren;
-	std::vector<RoomId> childrenToVisit;
-
+	// Nodes point into roomTree, which stays put while rooms are generated
 	// Process root nodes
-	Array<Number> dataPoints;
-	for (auto& node : nodes) {
-		if (parent.has_value()) {
-			node.area = parent.value().roomId.name;
+	ArenaVector<Number> dataPoints(&arena);
+	dataPoints.reserve(nodes.size());
+	for (RoomId* node : nodes) {
+		if (parentIndex >= 0) {
+			node->area = this->rooms[parentIndex].roomId.name;
 		}
 
-		dataPoints.emplace_back((float)node.size);
+		dataPoints.emplace_back((float)node->size);
 
-		if (node.hasChildren) {
-			int idx = 0;
-			for (auto& child : node.children) {
-				childrenToVisit.emplace_back(child);
-				idx++;
-			}
+		if (node->hasChildren) {
 			areas.emplace_back(node);
 		}
 	}
 	// datapoints
 	// container
-	auto result = SolveSquarifiedTreemap(dataPoints, container);
-	for (int i = 0; i < result.size(); ++i) {
+	ArenaVector<Rectangle> result(dataPoints.size(), &arena);
+	SolveSquarifiedTreemap(dataPoints, container, result);
+	int firstRoom = (int)this->rooms.size();
+	for (int i = 0; i < (int)result.size(); ++i) {
 		auto& rect = result[i];
-		auto& childRoomId = nodes[i];
-		GeneratedRoom room = GeneratedRoom(rect.X, rect.Y, rect.Width, rect.Height, childRoomId);
-		this->rooms.emplace_back(room);
+		this->rooms.emplace_back(rect.X, rect.Y, rect.Width, rect.Height, *nodes[i]);
+	}
 
-		if (childRoomId.hasChildren) {
-			std::pair<GeneratedRoom, std::vector<RoomId>> roomChildren = std::make_pair(room, childrenToVisit);
-			roomIdsWithChildren.emplace_back(roomChildren);
+	// Every area lays out its own children inside its room
+	for (int i = 0; i < (int)nodes.size(); ++i) {
+		if (!nodes[i]->hasChildren) {
+			continue;
 		}
-	}
 
-	if (!roomIdsWithChildren.empty()) {
-		for (auto& room : roomIdsWithChildren) {
-			std::vector<RoomId> children = room.second;
-			GeneratedRoom parent = room.first;
-			processNodes(children, std::make_optional(parent));
+		ArenaVector<RoomId*> children(&arena);
+		children.reserve(nodes[i]->children.size());
+		for (auto& child : nodes[i]->children) {
+			children.emplace_back(&child);
 		}
+		processNodes(children, firstRoom + i);
 	}
 }
 
-uint8_t RoomHandler::randomWallNumber(std::vector<uint8_t> validWalls)
+uint8_t RoomHandler::randomWallNumber(Span<const uint8_t> validWalls)
 {
-	std::vector<uint8_t>::iterator randIt = validWalls.begin();
-	std::advance(randIt, std::rand() % validWalls.size());
-	uint8_t wallNumber = *randIt;
-	return wallNumber;
+	return validWalls[std::rand() % validWalls.size()];
 }
 
 void RoomHandler::findRoomNeighbors()
 {
-	this->rooms[0].isConnectedToStart = true;
-	for (auto& room : this->rooms) {
-		room.isVisited = true;
-		if (room.roomId.hasChildren) {
-			continue;
+	edges.clear();
+
+	// Sweep over the leaf rooms sorted by their left edge. Only rooms starting
+	// before the current one ends can touch it, so each room is compared with a
+	// short run of candidates instead of every other room.
+	ArenaVector<int> leaves(&arena);
+	leaves.reserve(this->rooms.size());
+	for (int i = 0; i < (int)this->rooms.size(); i++) {
+		if (!this->rooms[i].roomId.hasChildren) {
+			leaves.emplace_back(i);
 		}
-		for (auto& other : this->rooms) {
-			if (&room == &other || other.roomId.hasChildren || other.isVisited) {
-				continue;
-			}
+	}
+	std::sort(leaves.begin(), leaves.end(), [this](int a, int b) {
+		return this->rooms[a].x < this->rooms[b].x;
+	});
 
-			bool xOverlap = (room.x <= (other.x + other.width)) && ((room.x + room.width) >= other.x);
-			bool yOverlap = (room.y <= (other.y + other.height)) && ((room.y + room.height) >= other.y);
+	ArenaVector<std::pair<int, int>> touching(&arena);
+	for (int a = 0; a < (int)leaves.size(); a++) {
+		const GeneratedRoom& room = this->rooms[leaves[a]];
+		float right = room.x + room.width;
 
-			if (!xOverlap || !yOverlap) {
-				continue;
+		for (int b = a + 1; b < (int)leaves.size() && this->rooms[leaves[b]].x <= right; b++) {
+			const GeneratedRoom& other = this->rooms[leaves[b]];
+			bool yOverlap = (room.y <= (other.y + other.height)) && ((room.y + room.height) >= other.y);
+			if (yOverlap) {
+				touching.emplace_back(std::min(leaves[a], leaves[b]), std::max(leaves[a], leaves[b]));
 			}
-			room.addNeighbor(other);
-
-			// Create wall segments
-			float xStart = std::max(room.x, other.x);
-			float xEnd = std::min(room.x + room.width, other.x + other.width);
-
-			float yStart = std::max(room.y, other.y);
-			float yEnd = std::min(room.y + room.height, other.y + other.height);
-
-			bool isDoor = !other.isConnectedToStart;
-			
-			bool hasArea = room.roomId.area != "Default";
-			if (room.roomId.area == other.roomId.area) {
-				if (hasArea) {
-					isDoor = true;
-				}
+		}
+	}
+
+	// Doors depend on which rooms are already connected, so walls are made in
+	// room order like the pairwise scan did
+	std::sort(touching.begin(), touching.end());
+	edges.reserve(touching.size());
+	walls.reserve(walls.size() + touching.size() + countOuterWalls()); // Outer walls come after
+	size_t wallCapacity = walls.capacity();
+	size_t edgeCapacity = edges.capacity();
+
+	// Doors to areas only go to the largest child, last area with a name wins
+	typedef std::pair<const std::string, const std::string*> AreaEntrance;
+	std::unordered_map<std::string, const std::string*, std::hash<std::string>, std::equal_to<std::string>, ArenaAllocator<AreaEntrance>>
+		areaEntrances(this->areas.size(), std::hash<std::string>(), std::equal_to<std::string>(), &arena);
+	for (const RoomId* area : this->areas) {
+		const GeneratedRoom* largestChild = findLargestRoom(area->children);
+		areaEntrances[area->name] = largestChild != nullptr ? &largestChild->roomId.name : nullptr;
+	}
+
+	this->rooms[0].isConnectedToStart = true;
+	for (const auto& pair : touching) {
+		const GeneratedRoom& room = this->rooms[pair.first];
+		GeneratedRoom& other = this->rooms[pair.second];
+
+		// Create wall segments
+		float xStart = std::max(room.x, other.x);
+		float xEnd = std::min(room.x + room.width, other.x + other.width);
+
+		float yStart = std::max(room.y, other.y);
+		float yEnd = std::min(room.y + room.height, other.y + other.height);
+
+		bool isDoor = !other.isConnectedToStart;
+
+		bool hasArea = room.roomId.area != "Default";
+		if (room.roomId.area == other.roomId.area) {
+			if (hasArea) {
+				isDoor = true;
 			}
-			// Doors to areas: only make a door to the largest child
-			else {
-				RoomId currArea;
-				for (auto& area : this->areas) {
-					if (area.name == other.roomId.area) {
-						currArea = area;
-					}
-				}
-				if (&currArea != nullptr) {
-					auto largestChild = findLargestRoom(currArea.children);
-					if (largestChild.has_value()) {
-						if (other.roomId.name == largestChild.value().roomId.name) {
-							isDoor = true;
-						}
-						else {
-							isDoor = false;
-						}
-					}
-				}				
+		}
+		else {
+			auto entrance = areaEntrances.find(other.roomId.area);
+			if (entrance != areaEntrances.end() && entrance->second != nullptr) {
+				isDoor = other.roomId.name == *entrance->second;
 			}
-			Wall wall = Wall(xStart, yStart, xEnd, yEnd, isDoor);
-			walls.emplace_back(wall);
-			other.isConnectedToStart = wall.doorSuccess;
 		}
+		walls.emplace_back(xStart, yStart, xEnd, yEnd, isDoor);
+		other.isConnectedToStart = walls.back().doorSuccess;
+
+		edges.push_back(RoomEdge{ pair.first, pair.second, (int)walls.size() - 1 });
 	}
+	assert(walls.capacity() == wallCapacity);
+	assert(edges.capacity() == edgeCapacity);
+
+	buildAdjacency();
 }
 
-std::vector<GeneratedRoom> RoomHandler::getRooms()
+void RoomHandler::buildAdjacency()
+{
+	// Compressed rows: neighbors of room i are neighbors[offsets[i]..offsets[i + 1]]
+	int roomCount = (int)this->rooms.size();
+	neighborOffsets.assign(roomCount + 1, 0);
+	connectedOffsets.assign(roomCount + 1, 0);
+
+	for (const auto& edge : edges) {
+		neighborOffsets[edge.first + 1]++;
+		neighborOffsets[edge.second + 1]++;
+		if (isConnected(edge)) {
+			connectedOffsets[edge.first + 1]++;
+			connectedOffsets[edge.second + 1]++;
+		}
+	}
+	for (int i = 0; i < roomCount; i++) {
+		neighborOffsets[i + 1] += neighborOffsets[i];
+		connectedOffsets[i + 1] += connectedOffsets[i];
+	}
+
+	neighbors.resize(neighborOffsets[roomCount]);
+	connectedNeighbors.resize(connectedOffsets[roomCount]);
+
+	ArenaVector<int> neighborFill(neighborOffsets.begin(), neighborOffsets.end() - 1, &arena);
+	ArenaVector<int> connectedFill(connectedOffsets.begin(), connectedOffsets.end() - 1, &arena);
+	for (const auto& edge : edges) {
+		neighbors[neighborFill[edge.first]++] = edge.second;
+		neighbors[neighborFill[edge.second]++] = edge.first;
+		if (isConnected(edge)) {
+			connectedNeighbors[connectedFill[edge.first]++] = edge.second;
+			connectedNeighbors[connectedFill[edge.second]++] = edge.first;
+		}
+	}
+}
+
+bool RoomHandler::isConnected(const RoomEdge& edge) const
+{
+	const Wall& wall = this->walls[edge.wall];
+	return wall.hasDoor && wall.doorSuccess;
+}
+
+Span<const RoomHandler::RoomEdge> RoomHandler::getEdges() const
+{
+	return edges;
+}
+
+Span<const int> RoomHandler::getNeighbors(int room) const
+{
+	return Span<const int>(neighbors.data() + neighborOffsets[room], neighborOffsets[room + 1] - neighborOffsets[room]);
+}
+
+Span<const int> RoomHandler::getConnectedNeighbors(int room) const
+{
+	return Span<const int>(connectedNeighbors.data() + connectedOffsets[room], connectedOffsets[room + 1] - connectedOffsets[room]);
+}
+
+Span<const GeneratedRoom> RoomHandler::getRooms() const
 {
 	return this->rooms;
 }
 
-std::optional<GeneratedRoom> RoomHandler::findLargestRoom(std::vector<RoomId>& rooms) {
+const GeneratedRoom* RoomHandler::findLargestRoom(const std::vector<RoomId>& rooms) const {
 	if (rooms.empty()) {
-		return {};
+		return nullptr;
 	}
 
-	RoomId largestRoomId = rooms[0];
+	const RoomId* largestRoomId = &rooms[0];
 
-	for (RoomId& roomId : rooms) {
-		if (roomId.size > largestRoomId.size) {
-			largestRoomId = roomId;
+	for (const RoomId& roomId : rooms) {
+		if (roomId.size > largestRoomId->size) {
+			largestRoomId = &roomId;
 		}
 	}
-	std::optional<GeneratedRoom> optionalLargestRoom = findRoomWithId(largestRoomId);
-
-	if (optionalLargestRoom.has_value()) {
-		GeneratedRoom largestRoom = optionalLargestRoom.value();
-		return largestRoom;
-	}
-	return {};
+	return findRoomWithId(*largestRoomId);
 }
 
-std::optional<GeneratedRoom> RoomHandler::findRoomWithId(RoomId id)
+const GeneratedRoom* RoomHandler::findRoomWithId(const RoomId& id) const
 {
-	for (auto& room : this->rooms) {
+	for (const auto& room : this->rooms) {
 		if (room.roomId.name == id.name) {
-			return std::make_optional(room);
+			return &room;
 		}
 	}
-	return {};
+	return nullptr;
 }
@@ -0,0 +1,250 @@
+#include "../headers/map_file.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MapFile::MapFile() { }
+
+MapFile::~MapFile()
+{
+    close();
+}
+
+bool MapFile::open(std::string path)
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        printf( "Unable to open map file %s!\n", path.c_str() );
+        return false;
+    }
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx( file, &fileSize );
+    size = fileSize.QuadPart;
+
+    mappingHandle = size > 0 ? CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL ) : NULL;
+    data = mappingHandle != NULL ? (const Uint8*)MapViewOfFile( mappingHandle, FILE_MAP_READ, 0, 0, 0 ) : NULL;
+#else
+    fileDescriptor = ::open( path.c_str(), O_RDONLY );
+    if( fileDescriptor < 0 )
+    {
+        printf( "Unable to open map file %s!\n", path.c_str() );
+        return false;
+    }
+
+    struct stat fileStat;
+    fstat( fileDescriptor, &fileStat );
+    size = fileStat.st_size;
+
+    if( size > 0 )
+    {
+        void* mapped = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+        data = mapped != MAP_FAILED ? (const Uint8*)mapped : NULL;
+    }
+#endif
+
+    if( data == NULL || size < sizeof( MapFileHeader ) )
+    {
+        printf( "Unable to map map file %s!\n", path.c_str() );
+        close();
+        return false;
+    }
+
+    MapFileHeader header;
+    memcpy( &header, data, sizeof( header ) );
+
+    Uint32 version = SDL_SwapLE32( header.version );
+    Uint32 dataOffset = SDL_SwapLE32( header.dataOffset );
+    Uint64 tileAmount = (Uint64)SDL_SwapLE32( header.width ) * SDL_SwapLE32( header.height );
+
+    if( memcmp( header.magic, MAP_FILE_MAGIC, sizeof( MAP_FILE_MAGIC ) ) != 0 )
+    {
+        printf( "%s is not a binary map file!\n", path.c_str() );
+        close();
+        return false;
+    }
+    if( version != MAP_FILE_VERSION )
+    {
+        printf( "Map file %s has version %u, expected %u!\n", path.c_str(), version, MAP_FILE_VERSION );
+        close();
+        return false;
+    }
+    if( dataOffset < sizeof( MapFileHeader ) || dataOffset > size || tileAmount > size - dataOffset )
+    {
+        printf( "Map file %s is truncated!\n", path.c_str() );
+        close();
+        return false;
+    }
+
+    width = SDL_SwapLE32( header.width );
+    height = SDL_SwapLE32( header.height );
+    tilesetId = SDL_SwapLE32( header.tilesetId );
+    tiles = data + dataOffset;
+
+    return true;
+}
+
+void MapFile::close()
+{
+#if defined(_WIN32)
+    if( data != NULL )
+    {
+        UnmapViewOfFile( data );
+    }
+    if( mappingHandle != NULL )
+    {
+        CloseHandle( mappingHandle );
+    }
+    if( fileHandle != NULL )
+    {
+        CloseHandle( fileHandle );
+    }
+    mappingHandle = NULL;
+    fileHandle = NULL;
+#else
+    if( data != NULL )
+    {
+        munmap( (void*)data, size );
+    }
+    if( fileDescriptor >= 0 )
+    {
+        ::close( fileDescriptor );
+    }
+    fileDescriptor = -1;
+#endif
+
+    data = NULL;
+    size = 0;
+    tiles = NULL;
+    width = 0;
+    height = 0;
+    tilesetId = 0;
+}
+
+bool MapFile::isOpen()
+{
+    return tiles != NULL;
+}
+
+int MapFile::getWidth()
+{
+    return width;
+}
+
+int MapFile::getHeight()
+{
+    return height;
+}
+
+int MapFile::getTilesetId()
+{
+    return tilesetId;
+}
+
+const Uint8* MapFile::getTiles()
+{
+    return tiles;
+}
+
+bool MapFile::write(std::string path, int width, int height, int tilesetId, const std::vector<Uint8>& tiles)
+{
+    if( (int)tiles.size() != width * height )
+    {
+        printf( "Map for %s has %d tiles, expected %d!\n", path.c_str(), (int)tiles.size(), width * height );
+        return false;
+    }
+
+    std::ofstream out( path, std::ios::binary );
+    if( !out )
+    {
+        printf( "Unable to open %s for writing!\n", path.c_str() );
+        return false;
+    }
+
+    MapFileHeader header;
+    memcpy( header.magic, MAP_FILE_MAGIC, sizeof( MAP_FILE_MAGIC ) );
+    header.version = SDL_SwapLE32( MAP_FILE_VERSION );
+    header.width = SDL_SwapLE32( width );
+    header.height = SDL_SwapLE32( height );
+    header.tilesetId = SDL_SwapLE32( tilesetId );
+    header.dataOffset = SDL_SwapLE32( sizeof( MapFileHeader ) );
+
+    out.write( (const char*)&header, sizeof( header ) );
+    out.write( (const char*)tiles.data(), tiles.size() );
+
+    return out.good();
+}
+
+bool MapFile::readText(std::string path, int tileTypes, int& width, int& height, std::vector<Uint8>& tiles)
+{
+    std::ifstream map( path );
+
+    if( map.fail() )
+    {
+        printf( "Unable to load map file!\n" );
+        return false;
+    }
+
+    tiles.clear();
+    width = 0;
+    height = 0;
+
+    std::string line;
+    while( std::getline( map, line ) )
+    {
+        std::istringstream row( line );
+        int rowWidth = 0;
+        int tileType;
+        while( row >> tileType )
+        {
+            if( ( tileType < 0 ) || ( tileType >= tileTypes ) )
+            {
+                printf( "Error loading map: Invalid tile type at %d!\n", (int)tiles.size() );
+                return false;
+            }
+
+            tiles.push_back( tileType );
+            rowWidth++;
+        }
+
+        if( rowWidth == 0 )
+        {
+            continue;
+        }
+
+        if( width == 0 )
+        {
+            width = rowWidth;
+        }
+        else if( rowWidth != width )
+        {
+            printf( "Error loading map: Row %d has %d tiles, expected %d!\n", height, rowWidth, width );
+            return false;
+        }
+        height++;
+    }
+
+    if( height == 0 )
+    {
+        printf( "Error loading map: Unexpected end of file!\n" );
+        return false;
+    }
+
+    return true;
+}
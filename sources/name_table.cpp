@@ -0,0 +1,42 @@
+#include "../headers/name_table.h"
+
+NameTable::NameTable()
+{
+    names.push_back("");
+}
+
+NameTable& NameTable::get()
+{
+    // Never destroyed, like the other engine singletons
+    static NameTable* instance = new NameTable();
+    return *instance;
+}
+
+Uint32 NameTable::intern(const std::string& name)
+{
+    if (name.empty())
+    {
+        return NO_NAME;
+    }
+
+    auto it = ids.find(name);
+    if (it != ids.end())
+    {
+        return it->second;
+    }
+
+    Uint32 id = names.size();
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+const std::string& NameTable::getString(Uint32 id)
+{
+    return names[id];
+}
+
+int NameTable::getSize()
+{
+    return names.size() - 1;
+}
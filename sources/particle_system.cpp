@@ -0,0 +1,147 @@
+#include "../headers/particle_system.h"
+#include <cstdlib>
+
+ParticleSystem::ParticleSystem(int capacity)
+{
+    this->capacity = capacity;
+
+    positionX.resize(capacity);
+    positionY.resize(capacity);
+    frames.resize(capacity);
+    colors.resize(capacity);
+}
+
+bool ParticleSystem::loadTextures(SDL_Renderer* renderer, const std::vector<std::string>& colorPaths, std::string shimmerPath)
+{
+    bool success = true;
+
+    colorTextures.resize(colorPaths.size());
+    for (size_t i = 0; i < colorPaths.size(); i++)
+    {
+        if (!colorTextures[i].loadFromFile(colorPaths[i], renderer))
+        {
+            printf( "Failed to load particle texture %s!\n", colorPaths[i].c_str() );
+            success = false;
+        }
+    }
+
+    if (!shimmerTexture.loadFromFile(shimmerPath, renderer))
+    {
+        printf( "Failed to load particle texture %s!\n", shimmerPath.c_str() );
+        success = false;
+    }
+
+    return success;
+}
+
+void ParticleSystem::freeTextures()
+{
+    for (auto& texture : colorTextures)
+    {
+        texture.free();
+    }
+    colorTextures.clear();
+    shimmerTexture.free();
+}
+
+void ParticleSystem::setAlpha(Uint8 alpha)
+{
+    for (auto& texture : colorTextures)
+    {
+        texture.setAlpha(alpha);
+    }
+    shimmerTexture.setAlpha(alpha);
+}
+
+void ParticleSystem::emit(int x, int y, int amount)
+{
+    int colorAmount = colorTextures.empty() ? 1 : colorTextures.size();
+
+    for (int i = 0; i < amount && count < capacity; i++)
+    {
+        positionX[count] = x - SPAWN_OFFSET + ( rand() % SPAWN_SPREAD );
+        positionY[count] = y - SPAWN_OFFSET + ( rand() % SPAWN_SPREAD );
+        frames[count] = rand() % START_FRAMES;
+        colors[count] = rand() % colorAmount;
+        count++;
+    }
+}
+
+void ParticleSystem::fill(int x, int y)
+{
+    emit(x, y, capacity - count);
+}
+
+void ParticleSystem::update()
+{
+    int i = 0;
+    while (i < count)
+    {
+        frames[i]++;
+        if (frames[i] > LIFETIME)
+        {
+            // The last particle moves into this slot, so look at it again
+            kill(i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void ParticleSystem::render(SDL_Renderer* renderer, int offsetX, int offsetY)
+{
+    if (colorTextures.empty())
+    {
+        return;
+    }
+
+    // Join the caller's batch if there is one, otherwise submit everything at once
+    bool ownBatch = SpriteBatch::getActive() == NULL;
+    if (ownBatch)
+    {
+        batch.begin();
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        int x = positionX[i] - offsetX;
+        int y = positionY[i] - offsetY;
+
+        colorTextures[colors[i]].render(x, y, NULL, 0.0, NULL, SDL_FLIP_NONE, renderer);
+        if (frames[i] % 2 == 0)
+        {
+            shimmerTexture.render(x, y, NULL, 0.0, NULL, SDL_FLIP_NONE, renderer);
+        }
+    }
+
+    if (ownBatch)
+    {
+        batch.end(renderer);
+    }
+}
+
+void ParticleSystem::clear()
+{
+    count = 0;
+}
+
+int ParticleSystem::getCount()
+{
+    return count;
+}
+
+int ParticleSystem::getCapacity()
+{
+    return capacity;
+}
+
+void ParticleSystem::kill(int index)
+{
+    count--;
+    positionX[index] = positionX[count];
+    positionY[index] = positionY[count];
+    frames[index] = frames[count];
+    colors[index] = colors[count];
+}
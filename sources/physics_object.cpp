@@ -2,25 +2,40 @@
 
 PhysicsObject::PhysicsObject(float m) : GameObject()
 {
-    mass = m;
+    EntityStore::get().addBody(getId()).mass = m;
 }
 
 PhysicsObject::PhysicsObject(int x, int y, int w, int h, float m) : GameObject(x, y, w, h)
 {
-    mass = m;
+    EntityStore::get().addBody(getId()).mass = m;
 }
 
 PhysicsObject::PhysicsObject(Vector2D pos, Vector2D s, Vector2D vel, std::string n, std::string path, float m) : GameObject(pos, s, vel, n, path)
 {
-    mass = m;
+    EntityStore::get().addBody(getId()).mass = m;
 }
 
 void PhysicsObject::setHasFriction(bool state)
 {
-    hasFriction = state;
+    getBody().hasFriction = state;
 }
 
 float PhysicsObject::getMass()
 {
-    return mass;
+    return getBody().mass;
+}
+
+void PhysicsObject::setSimulated(bool state)
+{
+    getBody().simulated = state;
+}
+
+bool PhysicsObject::isSimulated()
+{
+    return getBody().simulated;
+}
+
+PhysicsBody& PhysicsObject::getBody()
+{
+    return EntityStore::get().getBody(getId());
 }
@@ -1,99 +1,11 @@
 #include "../headers/player.h"
 #include "../headers/tile_map.h"
 
-bool checkCollision2( SDL_Rect a, SDL_Rect b )
-{
-    int leftA, leftB;
-    int rightA, rightB;
-    int topA, topB;
-    int bottomA, bottomB;
-
-    leftA = a.x;
-    rightA = a.x + a.w;
-    topA = a.y;
-    bottomA = a.y + a.h;
-
-    leftB = b.x;
-    rightB = b.x + b.w;
-    topB = b.y;
-    bottomB = b.y + b.h;
-
-    if( bottomA <= topB )
-    {
-        return false;
-    }
-
-    if( topA >= bottomB )
-    {
-        return false;
-    }
-
-    if( rightA <= leftB )
-    {
-        return false;
-    }
-
-    if( leftA >= rightB )
-    {
-        return false;
-    }
-
-    return true;
-}
-
-bool isSolid(Tile* t)
-{
-    switch(t->getType())
-    {
-        case (int)TileType::WALL_BOTTOM:
-        case (int)TileType::WALL_BOTTOM_LEFT:
-        case (int)TileType::WALL_BOTTOM_RIGHT:
-        case (int)TileType::WALL_TOP:
-        case (int)TileType::WALL_TOP_LEFT:
-        case (int)TileType::WALL_TOP_RIGHT:
-        case (int)TileType::WALL_CENTER:
-        case (int)TileType::WALL_LEFT:
-        case (int)TileType::WALL_RIGHT:
-        case (int)TileType::GOLD:
-            return true;
-    }
-    return false;
-}
-
-bool touchesWall( SDL_Rect box, Tile* tiles[] )
-{
-    for( int i = 0; i < 300; ++i )  // TODO: Hardcoded value
-    {
-        if( isSolid(tiles[ i ]) )
-        {
-            if( checkCollision2( box, tiles[ i ]->toBox() ) )
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
 Player::Player()
 {
     setPosition(Vector2D(0, 0));
     setSize(Vector2D(WIDTH, HEIGHT));
     setVelocity(Vector2D(0, 0));
-
-    for( int i = 0; i < TOTAL_PARTICLES; ++i )
-    {
-        particles[ i ] = new Particle( getPosition().getX(), getPosition().getY() );
-    }
-}
-
-Player::~Player()
-{
-    for( int i = 0; i < TOTAL_PARTICLES; ++i )
-    {
-        delete particles[ i ];
-    }
 }
 
 void Player::addAnimation(std::string path, SDL_Renderer* renderer)
@@ -156,12 +68,15 @@ void Player::handleEvent( SDL_Event& e )
     }
 }
 
-void Player::move( Tile *tiles[] )
+void Player::move( TileMap& map )
 {
+    int levelWidth = map.getWidth() * TILE_WIDTH;
+    int levelHeight = map.getHeight() * TILE_HEIGHT;
+
     getPosition().increaseX(getVelocity().getX());
 
     // If the player went too far to the left or right or touched a wall
-    if( ( getPosition().getX() < 0 ) || ( getPosition().getX() + WIDTH > LEVEL_WIDTH ) || touchesWall( toBox(), tiles ) )
+    if( ( getPosition().getX() < 0 ) || ( getPosition().getX() + WIDTH > levelWidth ) || map.overlapsSolid( toBox() ) )
     {
         // move back
         getPosition().decreaseX(getVelocity().getX());
@@ -170,7 +85,7 @@ void Player::move( Tile *tiles[] )
     getPosition().increaseY(getVelocity().getY());
 
     // If the player went too far up or down or touched a wall
-    if( ( getPosition().getY() < 0 ) || ( getPosition().getY() + HEIGHT > LEVEL_HEIGHT ) || touchesWall( toBox(), tiles ) )
+    if( ( getPosition().getY() < 0 ) || ( getPosition().getY() + HEIGHT > levelHeight ) || map.overlapsSolid( toBox() ) )
     {
         // move back
         getPosition().decreaseY(getVelocity().getY());
@@ -178,11 +93,22 @@ void Player::move( Tile *tiles[] )
 
 }
 
-void Player::setCamera( SDL_Rect& camera )
+void Player::setCamera( SDL_Rect& camera, TileMap& map )
 {
 	camera.x = ( getPosition().getX() + WIDTH / 2 ) - SCREEN_WIDTH / 2;
 	camera.y = ( getPosition().getY() + HEIGHT / 2 ) - SCREEN_HEIGHT / 2;
 
+	// Far edge first, so a map smaller than the camera stays at the origin
+	int levelWidth = map.getWidth() * TILE_WIDTH;
+	int levelHeight = map.getHeight() * TILE_HEIGHT;
+	if( camera.x > levelWidth - camera.w )
+	{
+		camera.x = levelWidth - camera.w;
+	}
+	if( camera.y > levelHeight - camera.h )
+	{
+		camera.y = levelHeight - camera.h;
+	}
 	if( camera.x < 0 )
 	{ 
 		camera.x = 0;
@@ -191,44 +117,27 @@ void Player::setCamera( SDL_Rect& camera )
 	{
 		camera.y = 0;
 	}
-	if( camera.x > LEVEL_WIDTH - camera.w )
-	{
-		camera.x = LEVEL_WIDTH - camera.w;
-	}
-	if( camera.y > LEVEL_HEIGHT - camera.h )
-	{
-		camera.y = LEVEL_HEIGHT - camera.h;
-	}
 }
 
 void Player::render( SDL_Rect& camera, SDL_Renderer* gRenderer )
 {
     if(playAnimation)
     {
-        activeAnimation->render({getPosition().getX() - camera.x, getPosition().getY() - camera.y}, gRenderer);
+        activeAnimation->render({getPosition().getX() - camera.x, getPosition().getY() - camera.y}, gRenderer, 0.0f);
     }
     else
     {
 	    getTexture().render( getPosition().getX() - camera.x, getPosition().getY() - camera.y, NULL, 0.0, NULL, SDL_FLIP_NONE, gRenderer);
     }
-	renderParticles(gRenderer);
+	renderParticles(camera, gRenderer);
 }
 
-void Player::renderParticles(SDL_Renderer* gRenderer)
+void Player::renderParticles( SDL_Rect& camera, SDL_Renderer* gRenderer )
 {
-    for( int i = 0; i < TOTAL_PARTICLES; ++i )
-    {
-        if( particles[ i ]->isDead() )
-        {
-            delete particles[ i ];
-            particles[ i ] = new Particle( getPosition().getX(), getPosition().getY() );
-        }
-    }
-
-    for( int i = 0; i < TOTAL_PARTICLES; ++i )
-    {
-        particles[ i ]->render(gRenderer);
-    }
+    // Dead particles are replaced in place, the pool never allocates
+    particles.update();
+    particles.fill( getPosition().getX(), getPosition().getY() );
+    particles.render( gRenderer, camera.x, camera.y );
 }
 
 Animation* Player::getAnimation()
@@ -0,0 +1,184 @@
+#include "../headers/profiler.h"
+#include "../headers/trace_recorder.h"
+#include <algorithm>
+#include <cstring>
+
+Profiler::Profiler()
+{
+    Scope frame;
+    frame.name = "Frame";
+    frame.parent = -1;
+    frame.depth = 0;
+    frame.history.assign(HISTORY_FRAMES, -1.0f);
+    scopes.push_back(frame);
+
+    stack.push_back(FRAME_SCOPE);
+    sortScratch.reserve(HISTORY_FRAMES);
+}
+
+Profiler& Profiler::get()
+{
+    // Never destroyed, so scopes in global destructors can still close
+    static Profiler* instance = new Profiler();
+    return *instance;
+}
+
+void Profiler::beginFrame()
+{
+    for (auto& scope : scopes)
+    {
+        scope.frameTime = 0.0f;
+        scope.ranThisFrame = false;
+    }
+
+    frameStart = SDL_GetPerformanceCounter();
+}
+
+void Profiler::endFrame()
+{
+    Uint64 frameEnd = SDL_GetPerformanceCounter();
+
+    Scope& frame = scopes[FRAME_SCOPE];
+    frame.frameTime = toMilliseconds(frameEnd - frameStart);
+    frame.ranThisFrame = true;
+    TraceRecorder::get().recordSlice(frame.name, frameStart, frameEnd);
+
+    for (auto& scope : scopes)
+    {
+        scope.history[historyIndex] = scope.ranThisFrame ? scope.frameTime : -1.0f;
+    }
+
+    historyIndex = (historyIndex + 1) % HISTORY_FRAMES;
+}
+
+void Profiler::beginScope(const char* name)
+{
+    int scope = findScope(stack.back(), name);
+    stack.push_back(scope);
+    startStack.push_back(SDL_GetPerformanceCounter());
+}
+
+void Profiler::endScope()
+{
+    // The frame scope is closed by endFrame, never by a ProfileScope
+    if (stack.size() <= 1)
+    {
+        return;
+    }
+
+    Uint64 end = SDL_GetPerformanceCounter();
+
+    Scope& scope = scopes[stack.back()];
+    scope.frameTime += toMilliseconds(end - startStack.back());
+    scope.ranThisFrame = true;
+    TraceRecorder::get().recordSlice(scope.name, startStack.back(), end);
+
+    stack.pop_back();
+    startStack.pop_back();
+}
+
+int Profiler::getScopeAmount()
+{
+    return scopes.size();
+}
+
+const char* Profiler::getScopeName(int scope)
+{
+    return scopes[scope].name;
+}
+
+int Profiler::getScopeDepth(int scope)
+{
+    return scopes[scope].depth;
+}
+
+Profiler::Stats Profiler::getStats(int scope)
+{
+    Stats stats;
+
+    sortScratch.clear();
+    for (float time : scopes[scope].history)
+    {
+        if (time >= 0.0f)
+        {
+            sortScratch.push_back(time);
+        }
+    }
+
+    if (sortScratch.empty())
+    {
+        return stats;
+    }
+
+    float total = 0.0f;
+    stats.min = sortScratch[0];
+    for (float time : sortScratch)
+    {
+        stats.min = std::min(stats.min, time);
+        total += time;
+    }
+
+    stats.frames = sortScratch.size();
+    stats.avg = total / stats.frames;
+
+    size_t p99Index = (sortScratch.size() - 1) * 99 / 100;
+    std::nth_element(sortScratch.begin(), sortScratch.begin() + p99Index, sortScratch.end());
+    stats.p99 = sortScratch[p99Index];
+
+    return stats;
+}
+
+int Profiler::findScope(int parent, const char* name)
+{
+    // Few enough scopes that a linear search beats hashing
+    for (int i = 0; i < (int)scopes.size(); i++)
+    {
+        if (scopes[i].parent == parent && (scopes[i].name == name || strcmp(scopes[i].name, name) == 0))
+        {
+            return i;
+        }
+    }
+
+    Scope scope;
+    scope.name = name;
+    scope.parent = parent;
+    scope.depth = scopes[parent].depth + 1;
+    scope.history.assign(HISTORY_FRAMES, -1.0f);
+
+    // Keep children right after their parent so the list reads as a tree
+    int index = parent + 1;
+    while (index < (int)scopes.size() && scopes[index].depth > scopes[parent].depth)
+    {
+        index++;
+    }
+
+    if (index == (int)scopes.size())
+    {
+        scopes.push_back(scope);
+        return index;
+    }
+
+    // Inserting shifts later scopes, so fix up parents and the open stack
+    scopes.insert(scopes.begin() + index, scope);
+    for (int i = index + 1; i < (int)scopes.size(); i++)
+    {
+        if (scopes[i].parent >= index)
+        {
+            scopes[i].parent++;
+        }
+    }
+    for (auto& open : stack)
+    {
+        if (open >= index)
+        {
+            open++;
+        }
+    }
+
+    return index;
+}
+
+float Profiler::toMilliseconds(Uint64 ticks)
+{
+    return (float)(ticks * 1000.0 / SDL_GetPerformanceFrequency());
+}
@@ -0,0 +1,98 @@
+#include "../headers/profiler_overlay.h"
+#include "../headers/profiler.h"
+#include <cstdio>
+
+ProfilerOverlay::ProfilerOverlay(int x, int y, std::string fontPath, int fontSize)
+    : UIObject(x, y, 0, 0)
+{
+    this->fontPath = fontPath;
+    this->fontSize = fontSize;
+}
+
+void ProfilerOverlay::handleEvent(SDL_Event* e)
+{
+    if( e->type == SDL_KEYDOWN && e->key.keysym.sym == SDLK_F3 && e->key.repeat == 0 )
+    {
+        setVisible(!visible);
+    }
+}
+
+void ProfilerOverlay::render(SDL_Renderer* renderer)
+{
+    if( !visible )
+    {
+        return;
+    }
+
+    if( framesUntilRefresh <= 0 )
+    {
+        refresh(renderer);
+        framesUntilRefresh = REFRESH_FRAMES;
+    }
+    framesUntilRefresh--;
+
+    for( int i = 0; i < lineAmount; i++ )
+    {
+        names[i].render(renderer);
+        stats[i].render(renderer);
+    }
+}
+
+void ProfilerOverlay::setVisible(bool state)
+{
+    visible = state;
+    framesUntilRefresh = 0;
+}
+
+bool ProfilerOverlay::isVisible()
+{
+    return visible;
+}
+
+void ProfilerOverlay::refresh(SDL_Renderer* renderer)
+{
+    Profiler& profiler = Profiler::get();
+
+    int x = getPosition().getX();
+    int y = getPosition().getY();
+
+    Text& nameHeader = getLine(names, 0);
+    nameHeader.updateContent("Scope");
+    nameHeader.setPosition(x, y);
+    nameHeader.loadTexture(renderer);
+
+    Text& statsHeader = getLine(stats, 0);
+    statsHeader.updateContent("min / avg / p99 (ms)");
+    statsHeader.setPosition(x + STATS_OFFSET, y);
+    statsHeader.loadTexture(renderer);
+
+    lineAmount = profiler.getScopeAmount() + 1;
+    for( int scope = 0; scope < profiler.getScopeAmount(); scope++ )
+    {
+        int lineY = y + (scope + 1) * fontSize;
+
+        Text& name = getLine(names, scope + 1);
+        name.updateContent(profiler.getScopeName(scope));
+        name.setPosition(x + profiler.getScopeDepth(scope) * INDENT, lineY);
+        name.loadTexture(renderer);
+
+        Profiler::Stats scopeStats = profiler.getStats(scope);
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.2f / %.2f / %.2f", scopeStats.min, scopeStats.avg, scopeStats.p99);
+
+        Text& values = getLine(stats, scope + 1);
+        values.updateContent(buffer);
+        values.setPosition(x + STATS_OFFSET, lineY);
+        values.loadTexture(renderer);
+    }
+}
+
+Text& ProfilerOverlay::getLine(std::vector<Text>& lines, int index)
+{
+    while( (int)lines.size() <= index )
+    {
+        lines.push_back(Text{"", 0, 0});
+        lines.back().loadFont(fontPath, fontSize);
+    }
+    return lines[index];
+}
@@ -1,4 +1,43 @@
 #include "../headers/scene.h"
+#include <cstring>
+
+static const char SCENE_FILE_MAGIC[4] = { 'L', 'D', 'S', 'C' };
+static const Uint32 SCENE_FILE_VERSION = 1;
+static const Uint32 SCENE_OBJECT_GAME_OBJECT = 0;
+static const Uint32 SCENE_MAX_STRING_LENGTH = 4096;
+
+// Binary scene values are little endian
+static void writeUint32(std::ostream& out, Uint32 value)
+{
+    value = SDL_SwapLE32(value);
+    out.write((const char*)&value, sizeof(value));
+}
+
+static void writeFloat(std::ostream& out, float value)
+{
+    value = SDL_SwapFloatLE(value);
+    out.write((const char*)&value, sizeof(value));
+}
+
+static bool readUint32(std::istream& in, Uint32& value)
+{
+    in.read((char*)&value, sizeof(value));
+    value = SDL_SwapLE32(value);
+    return in.good();
+}
+
+static bool readFloat(std::istream& in, float& value)
+{
+    in.read((char*)&value, sizeof(value));
+    value = SDL_SwapFloatLE(value);
+    return in.good();
+}
+
+static bool isBinaryScenePath(const std::string& path)
+{
+    size_t extension = path.rfind(SCENE_FILE_EXTENSION);
+    return extension != std::string::npos && extension + SCENE_FILE_EXTENSION.size() == path.size();
+}
 
 Scene::Scene()
 {
@@ -35,6 +74,7 @@ void Scene::handleEvent(SDL_Event* e)
 void Scene::addObj(GameObject* obj)
 {
     objs.push_back(obj);
+    nameIndex.emplace(obj->getName(), obj);
 }
 
 void Scene::setActive(bool state)
@@ -42,20 +82,19 @@ void Scene::setActive(bool state)
     isActive = state;
 }
 
-std::vector<GameObject*> Scene::getObjs()
+Span<GameObject* const> Scene::getObjs() const
 {
     return objs;
 }
 
 GameObject* Scene::getObjFromName(std::string name)
 {
-    for (auto* obj: objs)
+    auto it = nameIndex.find(name);
+    if (it == nameIndex.end())
     {
-        if(obj->getName() == name)
-        {
-            return obj;
-        }
+        return NULL;
     }
+    return it->second;
 }
 
 void Scene::loadTextures(SDL_Renderer* renderer)
@@ -66,17 +105,34 @@ void Scene::loadTextures(SDL_Renderer* renderer)
     }
 }
 
-void Scene::load(std::string path)
+bool Scene::load(std::string path)
 {
     std::cout << "load:" << path << std::endl;
     objs.clear();
-    std::ifstream file(path);
+    nameIndex.clear();
+
+    bool binary = isBinaryScenePath(path);
+    std::ifstream file(path, binary ? std::ios::binary : std::ios::in);
     if (!file.is_open()) 
     {
         std::cerr << "Failed to open file: " << path << std::endl;
-        return;
+        return false;
+    }
+
+    bool loaded = binary ? loadBinary(file) : loadText(file);
+    if (!loaded)
+    {
+        std::cerr << "Failed to load scene: " << path << std::endl;
     }
 
+    // Close the file
+    file.close();
+
+    return loaded;
+}
+
+bool Scene::loadText(std::istream& file)
+{
     std::string line;
     std::vector<std::string> objectData;
     while (std::getline(file, line)) 
@@ -186,8 +242,68 @@ void Scene::load(std::string path)
         }
     }
 
-    // Close the file
-    file.close();
+    return true;
+}
+
+bool Scene::loadBinary(std::istream& file)
+{
+    char magic[4];
+    file.read(magic, sizeof(magic));
+
+    Uint32 version, stringCount, objectCount;
+    if (!file.good() || memcmp(magic, SCENE_FILE_MAGIC, sizeof(magic)) != 0
+        || !readUint32(file, version) || !readUint32(file, stringCount) || !readUint32(file, objectCount))
+    {
+        std::cerr << "Not a binary scene file." << std::endl;
+        return false;
+    }
+
+    if (version != SCENE_FILE_VERSION)
+    {
+        std::cerr << "Unsupported scene version " << version << "." << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> strings;
+    for (Uint32 i = 0; i < stringCount; i++)
+    {
+        Uint32 length;
+        if (!readUint32(file, length) || length > SCENE_MAX_STRING_LENGTH)
+        {
+            return false;
+        }
+
+        strings.emplace_back(length, '\0');
+        file.read(&strings.back()[0], length);
+    }
+
+    // Objects are streamed one record at a time, nothing else is buffered
+    objs.reserve(objectCount);
+    for (Uint32 i = 0; i < objectCount; i++)
+    {
+        Uint32 type, name, texture;
+        float x, y, w, h, velocityX, velocityY;
+        if (!readUint32(file, type) || !readUint32(file, name) || !readUint32(file, texture)
+            || !readFloat(file, x) || !readFloat(file, y) || !readFloat(file, w) || !readFloat(file, h)
+            || !readFloat(file, velocityX) || !readFloat(file, velocityY))
+        {
+            std::cerr << "Scene ended after " << i << " of " << objectCount << " objects." << std::endl;
+            return false;
+        }
+
+        if (name >= strings.size() || texture >= strings.size())
+        {
+            std::cerr << "Scene object " << i << " refers to a missing string." << std::endl;
+            return false;
+        }
+
+        if (type == SCENE_OBJECT_GAME_OBJECT)
+        {
+            addObj(new GameObject{{x, y}, {w, h}, {velocityX, velocityY}, strings[name], strings[texture]});
+        }
+    }
+
+    return true;
 }
 
 void Scene::createEmptyObject()
@@ -195,19 +311,106 @@ void Scene::createEmptyObject()
     addObj(new GameObject{{0, 0}, {10, 10}, {0, 0}, "Empty Object", "./resources/gameobject.png"});
 }
 
-void Scene::save(std::string path)
+bool Scene::save(std::string path)
+{
+    bool binary = isBinaryScenePath(path);
+    std::ofstream file(path, binary ? std::ios::binary : std::ios::out);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open file for writing: " << path << std::endl;
+        return false;
+    }
+
+    if (binary)
+    {
+        saveBinary(file);
+    }
+    else
+    {
+        saveText(file);
+    }
+
+    bool saved = file.good();
+    file.close();
+    return saved;
+}
+
+// Unnamed objects are saved without a name, getName's "Object<id>" is only
+// meaningful for this run and would come back as a real, clashing name
+static std::string getSavedName(GameObject* obj)
 {
-    std::string objStr = "";
+    return obj->hasName() ? obj->getName() : "";
+}
+
+void Scene::saveText(std::ostream& file)
+{
+    // The loader reads whole numbers
+    for (auto* obj: objs)
+    {
+        file << "[\n";
+        file << "Type:GameObject;\n";
+        file << "Name:" << getSavedName(obj) << ";\n";
+        file << "Texture:" << obj->getTexturePath() << ";\n";
+        file << "Position:(" << (int)obj->getPosition().getX() << ", " << (int)obj->getPosition().getY() << ");\n";
+        file << "Size:(" << (int)obj->getSize().getX() << ", " << (int)obj->getSize().getY() << ");\n";
+        file << "Velocity:(" << (int)obj->getVelocity().getX() << ", " << (int)obj->getVelocity().getY() << ");\n";
+        file << "]\n";
+    }
+}
+
+void Scene::saveBinary(std::ostream& file)
+{
+    // Names and texture paths are stored once and referred to by index
+    std::vector<const std::string*> strings;
+    std::unordered_map<std::string, Uint32> stringIndex;
+    std::vector<Uint32> stringIndices; // Name then texture for every object
+    stringIndices.reserve(objs.size() * 2);
+
+    std::vector<std::string> names;
+    std::vector<std::string> texturePaths;
+    names.reserve(objs.size());
+    texturePaths.reserve(objs.size());
     for (auto* obj: objs)
     {
-        objStr += "[\n";
-        objStr += "Type:GameObject;\n";
-        objStr += "Name:" + obj->getName() + ";\n";
-        objStr += "Texture:./resources/gameobject.png;\n";
-        objStr += "Position:(" + std::to_string(obj->getPosition().getX()) + "," + std::to_string(obj->getPosition().getY()) + ");\n";
-        objStr += "Size:(" + std::to_string(obj->getSize().getX()) + "," + std::to_string(obj->getSize().getY()) + ");\n";
-        objStr += "Velocity:" + std::to_string(obj->getVelocity().getX()) + "," + std::to_string(obj->getVelocity().getY()) + ");\n";
-        objStr += "]\n";
-        // TODO: Save object to file and clear string.
-    }
-}
\ No newline at end of file
+        names.push_back(getSavedName(obj));
+        texturePaths.push_back(obj->getTexturePath());
+    }
+
+    for (size_t i = 0; i < objs.size(); i++)
+    {
+        for (const std::string* value : { &names[i], &texturePaths[i] })
+        {
+            auto inserted = stringIndex.emplace(*value, (Uint32)strings.size());
+            if (inserted.second)
+            {
+                strings.push_back(value);
+            }
+            stringIndices.push_back(inserted.first->second);
+        }
+    }
+
+    file.write(SCENE_FILE_MAGIC, sizeof(SCENE_FILE_MAGIC));
+    writeUint32(file, SCENE_FILE_VERSION);
+    writeUint32(file, strings.size());
+    writeUint32(file, objs.size());
+
+    for (auto* value : strings)
+    {
+        writeUint32(file, value->size());
+        file.write(value->data(), value->size());
+    }
+
+    for (size_t i = 0; i < objs.size(); i++)
+    {
+        GameObject* obj = objs[i];
+        writeUint32(file, SCENE_OBJECT_GAME_OBJECT);
+        writeUint32(file, stringIndices[i * 2]);
+        writeUint32(file, stringIndices[i * 2 + 1]);
+        writeFloat(file, obj->getPosition().getX());
+        writeFloat(file, obj->getPosition().getY());
+        writeFloat(file, obj->getSize().getX());
+        writeFloat(file, obj->getSize().getY());
+        writeFloat(file, obj->getVelocity().getX());
+        writeFloat(file, obj->getVelocity().getY());
+    }
+}
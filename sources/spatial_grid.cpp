@@ -0,0 +1,164 @@
+#include "../headers/spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(int cellSize)
+{
+    this->cellSize = cellSize;
+}
+
+int64_t SpatialGrid::getCellKey(int x, int y)
+{
+    return ((int64_t)x << 32) ^ (uint32_t)y;
+}
+
+SpatialGrid::CellRange SpatialGrid::getCellRange(GameObject* obj)
+{
+    // Bounding box of the rectangle rotated around its center
+    float halfWidth = obj->getSize().getX() / 2;
+    float halfHeight = obj->getSize().getY() / 2;
+
+    float radians = obj->getRotation() * (M_PI / 180.0);
+    float cosine = std::fabs(std::cos(radians));
+    float sine = std::fabs(std::sin(radians));
+
+    float extentX = cosine * halfWidth + sine * halfHeight;
+    float extentY = sine * halfWidth + cosine * halfHeight;
+
+    float centerX = obj->getPosition().getX() + halfWidth;
+    float centerY = obj->getPosition().getY() + halfHeight;
+
+    CellRange range;
+    range.minX = (int)std::floor((centerX - extentX) / cellSize);
+    range.minY = (int)std::floor((centerY - extentY) / cellSize);
+    range.maxX = (int)std::floor((centerX + extentX) / cellSize);
+    range.maxY = (int)std::floor((centerY + extentY) / cellSize);
+    return range;
+}
+
+void SpatialGrid::addToCells(GameObject* obj, const CellRange& range)
+{
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            cells[getCellKey(x, y)].push_back(obj);
+        }
+    }
+}
+
+void SpatialGrid::removeFromCells(GameObject* obj, const CellRange& range)
+{
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            auto it = cells.find(getCellKey(x, y));
+            if (it == cells.end())
+            {
+                continue;
+            }
+
+            std::vector<GameObject*>& bucket = it->second;
+            auto found = std::find(bucket.begin(), bucket.end(), obj);
+            if (found != bucket.end())
+            {
+                // Order within a cell does not matter
+                *found = bucket.back();
+                bucket.pop_back();
+            }
+        }
+    }
+}
+
+void SpatialGrid::insert(GameObject* obj)
+{
+    if (objectCells.count(obj) > 0)
+    {
+        update(obj);
+        return;
+    }
+
+    CellRange range = getCellRange(obj);
+    addToCells(obj, range);
+    objectCells[obj] = range;
+}
+
+void SpatialGrid::remove(GameObject* obj)
+{
+    auto it = objectCells.find(obj);
+    if (it == objectCells.end())
+    {
+        return;
+    }
+
+    removeFromCells(obj, it->second);
+    objectCells.erase(it);
+}
+
+void SpatialGrid::update(GameObject* obj)
+{
+    auto it = objectCells.find(obj);
+    if (it == objectCells.end())
+    {
+        insert(obj);
+        return;
+    }
+
+    CellRange range = getCellRange(obj);
+    if (range == it->second)
+    {
+        return;
+    }
+
+    removeFromCells(obj, it->second);
+    addToCells(obj, range);
+    it->second = range;
+}
+
+void SpatialGrid::clear()
+{
+    cells.clear();
+    objectCells.clear();
+}
+
+void SpatialGrid::query(GameObject* obj, std::vector<GameObject*>& candidates)
+{
+    candidates.clear();
+
+    auto it = objectCells.find(obj);
+    CellRange range = it != objectCells.end() ? it->second : getCellRange(obj);
+
+    for (int x = range.minX; x <= range.maxX; x++)
+    {
+        for (int y = range.minY; y <= range.maxY; y++)
+        {
+            auto cell = cells.find(getCellKey(x, y));
+            if (cell == cells.end())
+            {
+                continue;
+            }
+
+            for (auto* other : cell->second)
+            {
+                if (other != obj)
+                {
+                    candidates.push_back(other);
+                }
+            }
+        }
+    }
+
+    // Objects spanning several cells show up once per shared cell. Sorting by id
+    // rather than address keeps the contact order the same from run to run.
+    std::sort(candidates.begin(), candidates.end(), [](GameObject* a, GameObject* b) {
+        return a->getId() < b->getId();
+    });
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+int SpatialGrid::getObjectAmount()
+{
+    return objectCells.size();
+}
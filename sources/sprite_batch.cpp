@@ -0,0 +1,164 @@
+#include "../headers/sprite_batch.h"
+#include <algorithm>
+#include <cmath>
+
+SpriteBatch* SpriteBatch::active = NULL;
+
+SpriteBatch::SpriteBatch() { }
+
+SpriteBatch* SpriteBatch::getActive()
+{
+    return active;
+}
+
+void SpriteBatch::begin()
+{
+    commands.clear();
+    vertices.clear();
+    layer = 0;
+    active = this;
+}
+
+void SpriteBatch::setLayer(int layer)
+{
+    this->layer = layer;
+}
+
+int SpriteBatch::getLayer()
+{
+    return layer;
+}
+
+void SpriteBatch::draw( SDL_Texture* texture, int textureWidth, int textureHeight, SDL_Rect* clip, SDL_Rect dest, double angle, SDL_Point* center, SDL_RendererFlip flip, SDL_Color color )
+{
+    if( texture == NULL || textureWidth <= 0 || textureHeight <= 0 )
+    {
+        return;
+    }
+
+    SDL_Rect source = { 0, 0, textureWidth, textureHeight };
+    if( clip != NULL )
+    {
+        source = *clip;
+    }
+
+    float u0 = (float)source.x / textureWidth;
+    float v0 = (float)source.y / textureHeight;
+    float u1 = (float)(source.x + source.w) / textureWidth;
+    float v1 = (float)(source.y + source.h) / textureHeight;
+
+    if( flip & SDL_FLIP_HORIZONTAL )
+    {
+        std::swap(u0, u1);
+    }
+    if( flip & SDL_FLIP_VERTICAL )
+    {
+        std::swap(v0, v1);
+    }
+
+    // Corners relative to the rotation center, like SDL_RenderCopyEx
+    float cx = center != NULL ? center->x : dest.w / 2.0f;
+    float cy = center != NULL ? center->y : dest.h / 2.0f;
+
+    float corners[4][2] = {
+        { -cx,          -cy          },
+        { dest.w - cx,  -cy          },
+        { dest.w - cx,  dest.h - cy  },
+        { -cx,          dest.h - cy  }
+    };
+    float uvs[4][2] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+    float cosine = 1.0f;
+    float sine = 0.0f;
+    if( angle != 0.0 )
+    {
+        float radians = angle * (M_PI / 180.0);
+        cosine = std::cos(radians);
+        sine = std::sin(radians);
+    }
+
+    SDL_Vertex quad[4];
+    for( int i = 0; i < 4; i++ )
+    {
+        float x = corners[i][0];
+        float y = corners[i][1];
+        quad[i].position = { cosine * x - sine * y + dest.x + cx, sine * x + cosine * y + dest.y + cy };
+        quad[i].color = color;
+        quad[i].tex_coord = { uvs[i][0], uvs[i][1] };
+    }
+
+    drawQuad( texture, quad );
+}
+
+void SpriteBatch::drawQuad( SDL_Texture* texture, const SDL_Vertex quad[4] )
+{
+    if( texture == NULL )
+    {
+        return;
+    }
+
+    Command command;
+    command.layer = layer;
+    command.texture = texture;
+    command.order = commands.size();
+    command.firstVertex = vertices.size();
+    commands.push_back(command);
+
+    vertices.insert(vertices.end(), quad, quad + 4);
+}
+
+void SpriteBatch::end(SDL_Renderer* renderer)
+{
+    if( active == this )
+    {
+        active = NULL;
+    }
+
+    drawCalls = 0;
+
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        if( a.layer != b.layer )
+        {
+            return a.layer < b.layer;
+        }
+        if( a.texture != b.texture )
+        {
+            return a.texture < b.texture;
+        }
+        return a.order < b.order;
+    });
+
+    size_t i = 0;
+    while( i < commands.size() )
+    {
+        SDL_Texture* texture = commands[i].texture;
+
+        // Layers only order the runs, a texture run can span consecutive layers
+        indices.clear();
+        while( i < commands.size() && commands[i].texture == texture )
+        {
+            int first = commands[i].firstVertex;
+            indices.push_back(first);
+            indices.push_back(first + 1);
+            indices.push_back(first + 2);
+            indices.push_back(first);
+            indices.push_back(first + 2);
+            indices.push_back(first + 3);
+            i++;
+        }
+
+        // Modulation is carried by the vertex colors
+        SDL_SetTextureColorMod( texture, 0xFF, 0xFF, 0xFF );
+        SDL_SetTextureAlphaMod( texture, 0xFF );
+        SDL_RenderGeometry( renderer, texture, vertices.data(), vertices.size(), indices.data(), indices.size() );
+        drawCalls++;
+    }
+
+    commands.clear();
+    vertices.clear();
+}
+
+int SpriteBatch::getDrawCalls()
+{
+    return drawCalls;
+}
@@ -0,0 +1,40 @@
+#include "../headers/sprite_states.h"
+
+SpriteStates::SpriteStates()
+{
+    state = 0;
+}
+
+bool SpriteStates::addState(SDL_Renderer* renderer, std::string path)
+{
+    textures.emplace_back();
+    return textures.back().loadFromFile(path, renderer);
+}
+
+void SpriteStates::setState(int index)
+{
+    if (index >= 0 && index < (int)textures.size())
+    {
+        state = index;
+    }
+}
+
+int SpriteStates::getState()
+{
+    return state;
+}
+
+int SpriteStates::getStateAmount()
+{
+    return textures.size();
+}
+
+Texture& SpriteStates::getTexture()
+{
+    return textures[state];
+}
+
+Texture& SpriteStates::getTexture(int index)
+{
+    return textures[index];
+}
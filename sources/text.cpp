@@ -1,21 +1,89 @@
 #include "../headers/text.h"
+#include "../headers/profiler.h"
 #include <iostream>
 
 Text::Text(std::string content, int x, int y) : UIObject(x, y, 0, 0)
 {
     this->content = content;
+    fontEntry = NULL;
     color = { 0, 0, 0, 0xFF }; // TODO: Hardcoded color
 }
 
+Text::Text(const Text& other) : UIObject(other)
+{
+    content = other.content;
+    color = other.color;
+    atlas = other.atlas;
+    useAtlas = other.useAtlas;
+
+    fontEntry = other.fontEntry;
+    FontCache::get().retain( fontEntry );
+}
+
+Text::~Text()
+{
+    FontCache::get().release( fontEntry );
+}
+
+Text& Text::operator=(const Text& other)
+{
+    if( this == &other )
+    {
+        return *this;
+    }
+
+    UIObject::operator=(other);
+    content = other.content;
+    color = other.color;
+    atlas = other.atlas;
+    useAtlas = other.useAtlas;
+
+    FontCache::get().retain( other.fontEntry );
+    FontCache::get().release( fontEntry );
+    fontEntry = other.fontEntry;
+
+    return *this;
+}
+
 bool Text::loadFont(std::string path, int size)
 {
-    font = TTF_OpenFont( path.c_str(), size );
-    return ( font == NULL );
+    // Acquire before releasing so reloading the same font never closes it
+    FontCache::Entry* newEntry = FontCache::get().acquire( path, size );
+    FontCache::get().release( fontEntry );
+    fontEntry = newEntry;
+
+    atlas = GlyphAtlas::get( path, size );
+    return ( getFont() == NULL );
+}
+
+TTF_Font* Text::getFont()
+{
+    return fontEntry != NULL ? fontEntry->font : NULL;
 }
 
 bool Text::loadTexture(SDL_Renderer* renderer)
 {
-    return getTexture().loadFromRenderedText( content.c_str(), color, renderer, font );
+    PROFILE_SCOPE("Text::loadTexture");
+
+    // Nothing to rasterize into when running headless
+    if( renderer == NULL )
+    {
+        return false;
+    }
+
+    // Printable ASCII is drawn straight from the shared glyph atlas, anything else is rasterized as before
+    if( atlas != NULL && atlas->canRender( content ) && atlas->build( renderer, getFont() ) )
+    {
+        if( !useAtlas )
+        {
+            getTexture().free();
+            useAtlas = true;
+        }
+        return true;
+    }
+
+    useAtlas = false;
+    return getTexture().loadFromRenderedText( content.c_str(), color, renderer, getFont() );
 }
 
 void Text::updateContent(std::string content)
@@ -31,4 +99,4 @@ void Text::appendContent(std::string content)
 std::string Text::getContent()
 {
     return content;
-}
\ No newline at end of file
+}
@@ -1,11 +1,64 @@
 #include "../headers/texture.h"
+#include "../headers/profiler.h"
 #include <iostream> 
+#include <algorithm>
+#include <utility>
+
+SharedTexture::SharedTexture()
+{
+
+}
+
+SharedTexture::SharedTexture( TextureCache::Entry* entry )
+{
+	// Headless entries have no SDL texture, the entry is still released with the last handle
+	texture = std::shared_ptr<SDL_Texture>( entry->texture, [entry]( SDL_Texture* ) {
+		TextureCache::get().release( entry );
+	} );
+}
+
+SharedTexture::SharedTexture( SDL_Texture* texture )
+{
+	this->texture = std::shared_ptr<SDL_Texture>( texture, SDL_DestroyTexture );
+}
+
+SDL_Texture* SharedTexture::get() const
+{
+	return texture.get();
+}
+
+long SharedTexture::getUseCount() const
+{
+	return texture.use_count();
+}
+
+void SharedTexture::reset()
+{
+	texture.reset();
+}
 
 Texture::Texture()
 {
 	texture = NULL;
 	width = 0;
 	height = 0;
+	sourceWidth = 0;
+	sourceHeight = 0;
+	hasRegion = false;
+	region = { 0, 0, 0, 0 };
+}
+
+Texture::Texture( Texture&& other ) noexcept
+{
+	texture = NULL;
+	width = 0;
+	height = 0;
+	sourceWidth = 0;
+	sourceHeight = 0;
+	hasRegion = false;
+	region = { 0, 0, 0, 0 };
+
+	*this = std::move( other );
 }
 
 Texture::~Texture()
@@ -13,37 +66,102 @@ Texture::~Texture()
 	free();
 }
 
-bool Texture::loadFromFile( std::string path, SDL_Renderer* gRenderer )
+Texture& Texture::operator=( Texture&& other ) noexcept
 {
+	if( this == &other )
+	{
+		return *this;
+	}
+
 	free();
 
-	SDL_Texture* newTexture = NULL;
+	texture = other.texture;
+	shared = std::move( other.shared );
+	width = other.width;
+	height = other.height;
+	sourceWidth = other.sourceWidth;
+	sourceHeight = other.sourceHeight;
+	hasRegion = other.hasRegion;
+	region = other.region;
+	red = other.red;
+	green = other.green;
+	blue = other.blue;
+	alpha = other.alpha;
+	blendMode = other.blendMode;
+	hasBlendMode = other.hasBlendMode;
+
+	// The moved-from texture no longer references anything
+	other.texture = NULL;
+	other.shared.reset();
+	other.hasRegion = false;
+	other.width = 0;
+	other.height = 0;
+	other.sourceWidth = 0;
+	other.sourceHeight = 0;
+
+	return *this;
+}
 
-	SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
-	if( loadedSurface == NULL )
+Texture Texture::share() const
+{
+	Texture copy;
+	copy.texture = texture;
+	copy.shared = shared;
+	copy.width = width;
+	copy.height = height;
+	copy.sourceWidth = sourceWidth;
+	copy.sourceHeight = sourceHeight;
+	copy.hasRegion = hasRegion;
+	copy.region = region;
+	copy.red = red;
+	copy.green = green;
+	copy.blue = blue;
+	copy.alpha = alpha;
+	copy.blendMode = blendMode;
+	copy.hasBlendMode = hasBlendMode;
+	return copy;
+}
+
+bool Texture::loadFromFile( std::string path, SDL_Renderer* gRenderer )
+{
+	PROFILE_SCOPE( "Texture::loadFromFile" );
+
+	TextureAtlas* atlas = TextureAtlas::getActive();
+	SDL_Texture* page = NULL;
+	SDL_Rect pageRegion;
+	int pageWidth = 0;
+	int pageHeight = 0;
+	if( atlas != NULL && atlas->findRegion( path, page, pageRegion, pageWidth, pageHeight ) )
 	{
-		printf( "Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError() );
+		free();
+
+		texture = page;
+		hasRegion = true;
+		region = pageRegion;
+		width = region.w;
+		height = region.h;
+		sourceWidth = pageWidth;
+		sourceHeight = pageHeight;
+		return true;
 	}
-	else
-	{
-		SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
 
-        newTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
-		if( newTexture == NULL )
-		{
-			printf( "Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError() );
-		}
-		else
-		{
-			width = loadedSurface->w;
-			height = loadedSurface->h;
-		}
+	// Acquire before freeing so reloading the same path never drops the cached texture
+	TextureCache::Entry* newEntry = TextureCache::get().acquire( path, gRenderer );
+
+	free();
 
-		SDL_FreeSurface( loadedSurface );
+	if( newEntry != NULL )
+	{
+		shared = SharedTexture( newEntry );
+		texture = newEntry->texture;
+		width = newEntry->width;
+		height = newEntry->height;
+		sourceWidth = width;
+		sourceHeight = height;
 	}
 
-	texture = newTexture;
-	return texture != NULL;
+	// Headless entries have no SDL_Texture but still count as loaded
+	return newEntry != NULL;
 }
 
 #if defined(SDL_TTF_MAJOR_VERSION)
@@ -61,8 +179,11 @@ bool Texture::loadFromRenderedText( std::string textureText, SDL_Color textColor
 		}
 		else
 		{
+			shared = SharedTexture( texture );
 			width = textSurface->w;
 			height = textSurface->h;
+			sourceWidth = width;
+			sourceHeight = height;
 		}
 
 		SDL_FreeSurface( textSurface );
@@ -78,28 +199,32 @@ bool Texture::loadFromRenderedText( std::string textureText, SDL_Color textColor
 
 void Texture::free()
 {
-	if( texture != NULL )
-	{
-		SDL_DestroyTexture( texture );
-		texture = NULL;
-		width = 0;
-		height = 0;
-	}
+	// Atlas pages stay with the atlas, everything else goes when the last share is gone
+	shared.reset();
+	texture = NULL;
+	hasRegion = false;
+	width = 0;
+	height = 0;
+	sourceWidth = 0;
+	sourceHeight = 0;
 }
 
 void Texture::setColor( Uint8 red, Uint8 green, Uint8 blue )
 {
-	SDL_SetTextureColorMod( texture, red, green, blue );
+	this->red = red;
+	this->green = green;
+	this->blue = blue;
 }
 
 void Texture::setBlendMode( SDL_BlendMode blending )
 {
-	SDL_SetTextureBlendMode( texture, blending );
+	blendMode = blending;
+	hasBlendMode = true;
 }
 		
 void Texture::setAlpha( Uint8 alpha )
 {
-	SDL_SetTextureAlphaMod( texture, alpha );
+	this->alpha = alpha;
 }
 
 void Texture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip, SDL_Renderer* gRenderer )
@@ -112,6 +237,40 @@ void Texture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* cen
 		renderQuad.h = clip->h;
 	}
 
+	// Clips are relative to the image, move them into its atlas region without reaching neighbours
+	SDL_Rect regionClip;
+	if( hasRegion )
+	{
+		regionClip = { 0, 0, region.w, region.h };
+		if( clip != NULL )
+		{
+			regionClip = *clip;
+			regionClip.w = std::min( regionClip.w, region.w - regionClip.x );
+			regionClip.h = std::min( regionClip.h, region.h - regionClip.y );
+			renderQuad.w = regionClip.w;
+			renderQuad.h = regionClip.h;
+		}
+		regionClip.x += region.x;
+		regionClip.y += region.y;
+		clip = &regionClip;
+	}
+
+	if( hasBlendMode )
+	{
+		SDL_SetTextureBlendMode( texture, blendMode );
+	}
+
+	SpriteBatch* batch = SpriteBatch::getActive();
+	if( batch != NULL )
+	{
+		SDL_Color color = { red, green, blue, alpha };
+		batch->draw( texture, sourceWidth, sourceHeight, clip, renderQuad, angle, center, flip, color );
+		return;
+	}
+
+	SDL_SetTextureColorMod( texture, red, green, blue );
+	SDL_SetTextureAlphaMod( texture, alpha );
+
 	SDL_RenderCopyEx( gRenderer, texture, clip, &renderQuad, angle, center, flip );
 }
 
@@ -133,4 +292,38 @@ void Texture::setWidth(int w)
 void Texture::setHeight(int h)
 {
 	height = h;
-}
\ No newline at end of file
+}
+
+SDL_Texture* Texture::getSDLTexture()
+{
+	return texture;
+}
+
+SDL_FRect Texture::getTextureCoords( SDL_Rect* clip )
+{
+	SDL_Rect source = { 0, 0, sourceWidth, sourceHeight };
+	if( hasRegion )
+	{
+		source = region;
+	}
+
+	if( clip != NULL )
+	{
+		source.x += clip->x;
+		source.y += clip->y;
+		source.w = clip->w;
+		source.h = clip->h;
+		if( hasRegion )
+		{
+			source.w = std::min( source.w, region.w - clip->x );
+			source.h = std::min( source.h, region.h - clip->y );
+		}
+	}
+
+	if( sourceWidth <= 0 || sourceHeight <= 0 )
+	{
+		return { 0.0f, 0.0f, 0.0f, 0.0f };
+	}
+
+	return { (float)source.x / sourceWidth, (float)source.y / sourceHeight, (float)source.w / sourceWidth, (float)source.h / sourceHeight };
+}
@@ -0,0 +1,258 @@
+#include "../headers/texture_atlas.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+TextureAtlas* TextureAtlas::active = NULL;
+
+TextureAtlas::TextureAtlas() { }
+
+TextureAtlas::~TextureAtlas()
+{
+    free();
+}
+
+TextureAtlas* TextureAtlas::getActive()
+{
+    return active;
+}
+
+void TextureAtlas::setActive(TextureAtlas* atlas)
+{
+    active = atlas;
+}
+
+std::string TextureAtlas::normalizePath(std::string path)
+{
+    // "./resources/box.png" and "resources/box.png" name the same region
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool TextureAtlas::pack(std::vector<std::string> paths, int pageSize)
+{
+    free();
+    this->pageSize = pageSize;
+
+    std::vector<std::pair<std::string, SDL_Surface*>> images;
+    for (auto& path : paths)
+    {
+        SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
+        if( loadedSurface == NULL )
+        {
+            printf( "Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError() );
+            continue;
+        }
+
+        if( loadedSurface->w + PADDING > pageSize || loadedSurface->h + PADDING > pageSize )
+        {
+            printf( "Image %s does not fit in a %dx%d atlas page, it will be loaded on its own\n", path.c_str(), pageSize, pageSize );
+            SDL_FreeSurface( loadedSurface );
+            continue;
+        }
+
+        // Same color key as Texture::loadFromFile, then copy pixels as they are
+        SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
+        SDL_SetSurfaceBlendMode( loadedSurface, SDL_BLENDMODE_NONE );
+
+        images.push_back(std::make_pair(normalizePath(path), loadedSurface));
+    }
+
+    // Shelf packing, tallest first so each shelf wastes little height
+    std::sort(images.begin(), images.end(), [](const auto& a, const auto& b) {
+        return a.second->h > b.second->h;
+    });
+
+    int x = PADDING;
+    int y = PADDING;
+    int shelfHeight = 0;
+    for (auto& [path, surface] : images)
+    {
+        if (x + surface->w + PADDING > pageSize)
+        {
+            x = PADDING;
+            y += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+
+        if (pageSurfaces.empty() || y + surface->h + PADDING > pageSize)
+        {
+            SDL_Surface* page = SDL_CreateRGBSurfaceWithFormat( 0, pageSize, pageSize, 32, SDL_PIXELFORMAT_RGBA32 );
+            if (page == NULL)
+            {
+                printf( "Unable to create atlas page! SDL Error: %s\n", SDL_GetError() );
+                break;
+            }
+            SDL_FillRect( page, NULL, SDL_MapRGBA( page->format, 0, 0, 0, 0 ) );
+            pageSurfaces.push_back(page);
+
+            x = PADDING;
+            y = PADDING;
+            shelfHeight = 0;
+        }
+
+        Region region;
+        region.page = pageSurfaces.size() - 1;
+        region.rect = { x, y, surface->w, surface->h };
+        SDL_BlitSurface( surface, NULL, pageSurfaces.back(), &region.rect );
+        regions[path] = region;
+
+        x += surface->w + PADDING;
+        shelfHeight = std::max(shelfHeight, surface->h);
+    }
+
+    for (auto& [path, surface] : images)
+    {
+        SDL_FreeSurface( surface );
+    }
+
+    return !regions.empty();
+}
+
+bool TextureAtlas::save(std::string prefix)
+{
+    std::ofstream manifest(prefix + ".atlas");
+    if (!manifest)
+    {
+        std::cerr << "Error: Unable to open " << prefix << ".atlas for writing." << std::endl;
+        return false;
+    }
+
+    manifest << "pages " << pageSurfaces.size() << " " << pageSize << std::endl;
+    for (auto& [path, region] : regions)
+    {
+        manifest << region.page << " " << region.rect.x << " " << region.rect.y << " " << region.rect.w << " " << region.rect.h << " " << path << std::endl;
+    }
+
+    bool success = true;
+    for (int i = 0; i < (int)pageSurfaces.size(); i++)
+    {
+        std::string pagePath = prefix + "_" + std::to_string(i) + ".png";
+        if (IMG_SavePNG( pageSurfaces[i], pagePath.c_str() ) != 0)
+        {
+            printf( "Unable to save atlas page %s! SDL_image Error: %s\n", pagePath.c_str(), IMG_GetError() );
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+bool TextureAtlas::load(std::string prefix)
+{
+    free();
+
+    std::ifstream manifest(prefix + ".atlas");
+    if (!manifest)
+    {
+        return false;
+    }
+
+    std::string tag;
+    int pageAmount = 0;
+    manifest >> tag >> pageAmount >> pageSize;
+    if (tag != "pages" || manifest.fail())
+    {
+        std::cerr << "Error: Invalid atlas manifest " << prefix << ".atlas" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::istringstream iss(line);
+        Region region;
+        iss >> region.page >> region.rect.x >> region.rect.y >> region.rect.w >> region.rect.h;
+        std::string path;
+        std::getline(iss >> std::ws, path);
+        if (iss.fail() || path.empty())
+        {
+            continue;
+        }
+        regions[path] = region;
+    }
+
+    for (int i = 0; i < pageAmount; i++)
+    {
+        std::string pagePath = prefix + "_" + std::to_string(i) + ".png";
+        SDL_Surface* page = IMG_Load( pagePath.c_str() );
+        if (page == NULL)
+        {
+            printf( "Unable to load atlas page %s! SDL_image Error: %s\n", pagePath.c_str(), IMG_GetError() );
+            free();
+            return false;
+        }
+        pageSurfaces.push_back(page);
+    }
+
+    return true;
+}
+
+bool TextureAtlas::upload(SDL_Renderer* renderer)
+{
+    for (auto*& surface : pageSurfaces)
+    {
+        SDL_Texture* page = SDL_CreateTextureFromSurface( renderer, surface );
+        if (page == NULL)
+        {
+            printf( "Unable to create atlas page texture! SDL Error: %s\n", SDL_GetError() );
+            return false;
+        }
+        SDL_SetTextureBlendMode( page, SDL_BLENDMODE_BLEND );
+        pageTextures.push_back(page);
+        SDL_FreeSurface( surface );
+        surface = NULL;
+    }
+    pageSurfaces.clear();
+
+    return true;
+}
+
+bool TextureAtlas::findRegion(std::string path, SDL_Texture*& page, SDL_Rect& rect, int& pageWidth, int& pageHeight)
+{
+    auto it = regions.find(normalizePath(path));
+    if (it == regions.end() || it->second.page >= (int)pageTextures.size())
+    {
+        return false;
+    }
+
+    page = pageTextures[ it->second.page ];
+    rect = it->second.rect;
+    pageWidth = pageSize;
+    pageHeight = pageSize;
+    return true;
+}
+
+int TextureAtlas::getPageAmount()
+{
+    return std::max(pageSurfaces.size(), pageTextures.size());
+}
+
+int TextureAtlas::getRegionAmount()
+{
+    return regions.size();
+}
+
+void TextureAtlas::free()
+{
+    for (auto* surface : pageSurfaces)
+    {
+        SDL_FreeSurface( surface );
+    }
+    pageSurfaces.clear();
+
+    for (auto* texture : pageTextures)
+    {
+        SDL_DestroyTexture( texture );
+    }
+    pageTextures.clear();
+
+    regions.clear();
+}
@@ -0,0 +1,81 @@
+#include "../headers/texture_cache.h"
+#include "../headers/trace_recorder.h"
+#include <iostream>
+
+TextureCache::TextureCache() { }
+
+TextureCache& TextureCache::get()
+{
+    // Never destroyed, so global Textures can still release during static teardown
+    static TextureCache* instance = new TextureCache();
+    return *instance;
+}
+
+TextureCache::Entry* TextureCache::acquire(std::string path, SDL_Renderer* renderer)
+{
+    auto it = entries.find(path);
+    if (it != entries.end())
+    {
+        it->second.refCount++;
+        return &it->second;
+    }
+
+    TraceRecorder::get().recordInstant("asset", "Load texture", path.c_str());
+
+    SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
+    if( loadedSurface == NULL )
+    {
+        printf( "Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError() );
+        return NULL;
+    }
+
+    SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
+
+    // Without a renderer (headless) only the size is kept, objects still get their dimensions
+    SDL_Texture* newTexture = NULL;
+    if( renderer != NULL )
+    {
+        newTexture = SDL_CreateTextureFromSurface( renderer, loadedSurface );
+        if( newTexture == NULL )
+        {
+            printf( "Unable to create texture from %s! SDL Error: %s\n", path.c_str(), SDL_GetError() );
+            SDL_FreeSurface( loadedSurface );
+            return NULL;
+        }
+    }
+
+    Entry& entry = entries[path];
+    entry.path = path;
+    entry.texture = newTexture;
+    entry.width = loadedSurface->w;
+    entry.height = loadedSurface->h;
+    entry.refCount = 1;
+
+    SDL_FreeSurface( loadedSurface );
+
+    return &entry;
+}
+
+void TextureCache::release(Entry* entry)
+{
+    if (entry == NULL)
+    {
+        return;
+    }
+
+    entry->refCount--;
+    if (entry->refCount <= 0)
+    {
+        if( entry->texture != NULL )
+        {
+            SDL_DestroyTexture( entry->texture );
+        }
+        std::string path = entry->path;
+        entries.erase(path);
+    }
+}
+
+int TextureCache::getSize()
+{
+    return entries.size();
+}
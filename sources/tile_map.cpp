@@ -1,10 +1,12 @@
 #include "../headers/tile_map.h"
+#include "../headers/profiler.h"
 
 #include <stdio.h>
 #include <string>
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 void TileMap::saveTilesToFile(std::string name)
 {
@@ -16,29 +18,16 @@ void TileMap::saveTilesToFile(std::string name)
         std::cerr << "Error: Unable to open the file for writing." << std::endl;
     }
 
-	const int MAX_X = 20; // TODO: Hardcoded value, read from file
-	int x = 0;
-    for (int i = 0; i < TOTAL_TILES; ++i) {
-		std::stringstream ss;
-		ss << tiles[i]->getType();
-		if(ss.str().length() == 1) // num is one digit
-		{
-        	outFile << "0" + ss.str();
-		}
-		else
-		{
-        	outFile << tiles[i]->getType();
-		}
-		x++;
-		if(x >= MAX_X)
-		{
-			x = 0;
-			outFile << std::endl;
-		}
-		else
-		{
-			outFile << " ";
-		}
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int type = getTile(x, y);
+            if (type < 10) // Zero pad to two digits
+            {
+                outFile << '0';
+            }
+            outFile << type;
+            outFile << (x == width - 1 ? '\n' : ' ');
+        }
     }
 
     outFile.close();
@@ -48,79 +37,145 @@ void TileMap::saveTilesToFile(std::string name)
 
 TileMap::TileMap()
 {
+	for (int i = 0; i < TOTAL_TILE_TYPES; ++i)
+	{
+		clips[i].x = (i % (128 / TILE_WIDTH)) * TILE_WIDTH;		// TODO: Hardcoded values
+		clips[i].y = (i / (128 / TILE_WIDTH)) * TILE_HEIGHT;
+		clips[i].w = TILE_WIDTH;
+		clips[i].h = TILE_HEIGHT;
+	}
+
     setTiles("./resources/dkg-gold.map");
 }
 
 bool TileMap::setTiles(std::string mapPath)
 {
-	bool tilesLoaded = true;
-
-    int x = 0, y = 0;
+	size_t extension = mapPath.rfind( MAP_FILE_EXTENSION );
+	if( extension != std::string::npos && extension + MAP_FILE_EXTENSION.size() == mapPath.size() )
+	{
+		return loadBinary( mapPath );
+	}
 
-    std::ifstream map( mapPath );
+	int mapWidth = 0;
+	int mapHeight = 0;
+	std::vector<Uint8> loaded;
+	if( !MapFile::readText( mapPath, TOTAL_TILE_TYPES, mapWidth, mapHeight, loaded ) )
+	{
+		return false;
+	}
 
-    if( map.fail() )
-    {
-		printf( "Unable to load map file!\n" );
-		tilesLoaded = false;
-    }
-	else
+	resize( mapWidth, mapHeight );
+	for( int y = 0; y < mapHeight; ++y )
 	{
-		for( int i = 0; i < TOTAL_TILES; ++i )
+		for( int x = 0; x < mapWidth; ++x )
 		{
-			int tileType = -1;
+			setTile( x, y, loaded[ y * mapWidth + x ] );
+		}
+	}
 
-			map >> tileType;
+    return true;
+}
 
-			if( map.fail() )
-			{
-				printf( "Error loading map: Unexpected end of file!\n" );
-				tilesLoaded = false;
-				break;
-			}
+bool TileMap::loadBinary(std::string mapPath)
+{
+	resize( 0, 0 );
 
-			if( ( tileType >= 0 ) && ( tileType < TOTAL_TILE_TYPES ) )
-			{
-				tiles[ i ] = new Tile( x, y, tileType );
-			}
-			else
-			{
-				printf( "Error loading map: Invalid tile type at %d!\n", i );
-				tilesLoaded = false;
-				break;
-			}
+	if( !mapFile.open( mapPath ) )
+	{
+		return false;
+	}
 
-			x += TILE_WIDTH;
+	// Nothing is read here, chunks copy their tiles out of the mapping when first used
+	setSize( mapFile.getWidth(), mapFile.getHeight() );
+	tilesetId = mapFile.getTilesetId();
+	source = mapFile.getTiles();
 
-			if( x >= TOTAL_PIXEL_WIDTH )
-			{
-				x = 0;
+	return true;
+}
 
-				y += TILE_HEIGHT;
-			}
-		}
-		
-		if( tilesLoaded )
+bool TileMap::saveBinary(std::string name)
+{
+	std::vector<Uint8> tiles( width * height );
+	for( int y = 0; y < height; ++y )
+	{
+		for( int x = 0; x < width; ++x )
 		{
-			for (int i = 0; i < TOTAL_TILE_TYPES; ++i)
-			{
-				clips[i].x = (i % (128 / TILE_WIDTH)) * TILE_WIDTH;		// TODO: Hardcoded values
-				clips[i].y = (i / (128 / TILE_WIDTH)) * TILE_HEIGHT;
-				clips[i].w = TILE_WIDTH;
-				clips[i].h = TILE_HEIGHT;
-			}
+			tiles[ y * width + x ] = getTile( x, y );
 		}
 	}
 
-    map.close();
+	// Let go of the mapped file first, it may be the one being overwritten
+	for( int chunkY = 0; chunkY < chunksY; ++chunkY )
+	{
+		for( int chunkX = 0; chunkX < chunksX; ++chunkX )
+		{
+			loadChunk( chunks[ chunkY * chunksX + chunkX ], chunkX, chunkY );
+		}
+	}
+	source = NULL;
+	mapFile.close();
 
-    return tilesLoaded;
+	std::string fileName = name + MAP_FILE_EXTENSION;
+	bool saved = MapFile::write( fileName, width, height, tilesetId, tiles );
+	if( saved )
+	{
+		std::cout << "Map written to file: " << fileName << std::endl;
+	}
+	return saved;
 }
 
 void TileMap::render( SDL_Rect& camera, SDL_Renderer* renderer ) {
-    for( int i = 0; i < TOTAL_TILES; ++i )
+	PROFILE_SCOPE( "TileMap::render" );
+
+	SDL_Texture* texture = sheetTexture.getSDLTexture();
+	if( texture == NULL || chunks.empty() )
 	{
-		tiles[ i ]->render( camera, clips, renderer, sheetTexture);
+		return;
+	}
+
+	// Only the chunks the camera overlaps
+	const int CHUNK_PIXEL_WIDTH = CHUNK_SIZE * TILE_WIDTH;
+	const int CHUNK_PIXEL_HEIGHT = CHUNK_SIZE * TILE_HEIGHT;
+	int firstX = std::max( 0, camera.x / CHUNK_PIXEL_WIDTH );
+	int firstY = std::max( 0, camera.y / CHUNK_PIXEL_HEIGHT );
+	int lastX = std::min( chunksX - 1, ( camera.x + camera.w - 1 ) / CHUNK_PIXEL_WIDTH );
+	int lastY = std::min( chunksY - 1, ( camera.y + camera.h - 1 ) / CHUNK_PIXEL_HEIGHT );
+
+	// Queue into the caller's batch when there is one, otherwise submit all tiles at once
+	bool ownBatch = SpriteBatch::getActive() == NULL;
+	if( ownBatch )
+	{
+		batch.begin();
+	}
+	SpriteBatch* target = SpriteBatch::getActive();
+
+	for( int chunkY = firstY; chunkY <= lastY; ++chunkY )
+	{
+		for( int chunkX = firstX; chunkX <= lastX; ++chunkX )
+		{
+			Chunk& chunk = chunks[ chunkY * chunksX + chunkX ];
+			if( chunk.dirty )
+			{
+				buildGeometry( chunkX, chunkY );
+			}
+
+			// The cached quads are in world space, only the camera offset is applied per frame
+			for( size_t i = 0; i < chunk.vertices.size(); i += 4 )
+			{
+				for( int v = 0; v < 4; ++v )
+				{
+					quad[ v ] = chunk.vertices[ i + v ];
+					quad[ v ].position.x -= camera.x;
+					quad[ v ].position.y -= camera.y;
+				}
+				target->drawQuad( texture, quad );
+			}
+		}
+	}
+
+	if( ownBatch )
+	{
+		batch.end( renderer );
 	}
 }
 
@@ -129,36 +184,239 @@ Texture& TileMap::getTexture()
     return sheetTexture;
 }
 
-Tile** TileMap::getTiles()
+void TileMap::resize(int width, int height)
 {
-    return tiles;
+	source = NULL;
+	mapFile.close();
+	tilesetId = 0;
+
+	setSize( width, height );
 }
 
 void TileMap::deleteTiles()
 {
-    for( int i = 0; i < TOTAL_TILES; ++i )
-    {
-        if( tiles[ i ] != NULL )
-        {
-            delete tiles[ i ];
-            tiles[ i ] = NULL;
-        }
-    }
+	resize( 0, 0 );
 }
 
 bool TileMap::loadTexture( SDL_Renderer* renderer, std::string path )
 {
+	// Texture coordinates depend on the sheet, so every chunk has to be rebuilt
+	for( auto& chunk : chunks )
+	{
+		chunk.dirty = true;
+	}
+
     return sheetTexture.loadFromFile( path, renderer );
 }
 
-void TileMap::setTile(int index, Tile* t)
+int TileMap::getWidth()
+{
+	return width;
+}
+
+int TileMap::getHeight()
+{
+	return height;
+}
+
+int TileMap::getTilesetId()
 {
-	tiles[index] = t;
+	return tilesetId;
 }
 
-int TileMap::getTileFromScreenPosition(int x, int y)
+Uint8 TileMap::getTile(int x, int y)
 {
-	int tileX = (x / TILE_WIDTH);
-	int tileY = (y / TILE_HEIGHT);
-	return (tileY * (TOTAL_PIXEL_WIDTH / TILE_WIDTH) + tileX);
-}
\ No newline at end of file
+	if( x < 0 || y < 0 || x >= width || y >= height )
+	{
+		return (Uint8)TileType::DIRT;
+	}
+
+	// Reading never loads a chunk, untouched tiles come straight from the mapped file
+	Chunk& chunk = chunks[ ( y / CHUNK_SIZE ) * chunksX + ( x / CHUNK_SIZE ) ];
+	if( chunk.tiles.empty() )
+	{
+		return source != NULL ? toTileType( source[ y * width + x ] ) : (Uint8)TileType::DIRT;
+	}
+
+	return chunk.tiles[ ( y % CHUNK_SIZE ) * CHUNK_SIZE + ( x % CHUNK_SIZE ) ];
+}
+
+void TileMap::setTile(int x, int y, Uint8 type)
+{
+	if( x < 0 || y < 0 || x >= width || y >= height || type >= TOTAL_TILE_TYPES )
+	{
+		return;
+	}
+
+	Chunk& chunk = getChunk( x, y );
+	chunk.tiles[ ( y % CHUNK_SIZE ) * CHUNK_SIZE + ( x % CHUNK_SIZE ) ] = type;
+	chunk.dirty = true;
+
+	Uint32 bit = 1u << ( x % CHUNK_SIZE );
+	if( isSolidType( type ) )
+	{
+		chunk.solidRows[ y % CHUNK_SIZE ] |= bit;
+	}
+	else
+	{
+		chunk.solidRows[ y % CHUNK_SIZE ] &= ~bit;
+	}
+}
+
+int TileMap::getTileFromScreenPosition(int x, int y, const SDL_Rect& camera)
+{
+	int tileX = ((x + camera.x) / TILE_WIDTH);
+	int tileY = ((y + camera.y) / TILE_HEIGHT);
+	return (tileY * width + tileX);
+}
+
+bool TileMap::isSolidType(Uint8 type)
+{
+    switch(type)
+    {
+        case (int)TileType::WALL_BOTTOM:
+        case (int)TileType::WALL_BOTTOM_LEFT:
+        case (int)TileType::WALL_BOTTOM_RIGHT:
+        case (int)TileType::WALL_TOP:
+        case (int)TileType::WALL_TOP_LEFT:
+        case (int)TileType::WALL_TOP_RIGHT:
+        case (int)TileType::WALL_CENTER:
+        case (int)TileType::WALL_LEFT:
+        case (int)TileType::WALL_RIGHT:
+        case (int)TileType::GOLD:
+            return true;
+    }
+    return false;
+}
+
+bool TileMap::isSolid(int x, int y)
+{
+	if( x < 0 || y < 0 || x >= width || y >= height )
+	{
+		return false;
+	}
+
+	Chunk& chunk = getChunk( x, y );
+	return ( chunk.solidRows[ y % CHUNK_SIZE ] >> ( x % CHUNK_SIZE ) ) & 1;
+}
+
+bool TileMap::overlapsSolid(SDL_Rect box)
+{
+	if( box.w <= 0 || box.h <= 0 )
+	{
+		return false;
+	}
+
+	// Edges that only touch a tile don't count, like checkCollision
+	int firstX = std::max( 0, (int)floor( (float)box.x / TILE_WIDTH ) );
+	int firstY = std::max( 0, (int)floor( (float)box.y / TILE_HEIGHT ) );
+	int lastX = std::min( width - 1, (int)floor( (float)( box.x + box.w - 1 ) / TILE_WIDTH ) );
+	int lastY = std::min( height - 1, (int)floor( (float)( box.y + box.h - 1 ) / TILE_HEIGHT ) );
+
+	for( int y = firstY; y <= lastY; ++y )
+	{
+		for( int x = firstX; x <= lastX; ++x )
+		{
+			if( isSolid( x, y ) )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+TileMap::Chunk& TileMap::getChunk(int tileX, int tileY)
+{
+	int chunkX = tileX / CHUNK_SIZE;
+	int chunkY = tileY / CHUNK_SIZE;
+
+	Chunk& chunk = chunks[ chunkY * chunksX + chunkX ];
+	loadChunk( chunk, chunkX, chunkY );
+	return chunk;
+}
+
+void TileMap::loadChunk(Chunk& chunk, int chunkX, int chunkY)
+{
+	if( !chunk.tiles.empty() )
+	{
+		return;
+	}
+
+	chunk.tiles.assign( CHUNK_SIZE * CHUNK_SIZE, (Uint8)TileType::DIRT );
+	std::fill( chunk.solidRows, chunk.solidRows + CHUNK_SIZE, 0 );
+	if( source == NULL )
+	{
+		return;
+	}
+
+	int firstX = chunkX * CHUNK_SIZE;
+	int firstY = chunkY * CHUNK_SIZE;
+	int lastX = std::min( width, firstX + CHUNK_SIZE );
+	int lastY = std::min( height, firstY + CHUNK_SIZE );
+
+	for( int y = firstY; y < lastY; ++y )
+	{
+		for( int x = firstX; x < lastX; ++x )
+		{
+			Uint8 type = toTileType( source[ y * width + x ] );
+			chunk.tiles[ ( y - firstY ) * CHUNK_SIZE + ( x - firstX ) ] = type;
+			if( isSolidType( type ) )
+			{
+				chunk.solidRows[ y - firstY ] |= 1u << ( x - firstX );
+			}
+		}
+	}
+}
+
+void TileMap::setSize(int width, int height)
+{
+	this->width = width;
+	this->height = height;
+	chunksX = ( width + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+	chunksY = ( height + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+
+	chunks.assign( chunksX * chunksY, Chunk() );
+}
+
+Uint8 TileMap::toTileType(Uint8 id)
+{
+	// Mapped files are never validated up front, unknown IDs draw as dirt
+	return id < TOTAL_TILE_TYPES ? id : (Uint8)TileType::DIRT;
+}
+
+void TileMap::buildGeometry(int chunkX, int chunkY)
+{
+	Chunk& chunk = chunks[ chunkY * chunksX + chunkX ];
+	loadChunk( chunk, chunkX, chunkY );
+	chunk.vertices.clear();
+
+	int firstX = chunkX * CHUNK_SIZE;
+	int firstY = chunkY * CHUNK_SIZE;
+	int lastX = std::min( width, firstX + CHUNK_SIZE );
+	int lastY = std::min( height, firstY + CHUNK_SIZE );
+
+	SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+	for( int y = firstY; y < lastY; ++y )
+	{
+		for( int x = firstX; x < lastX; ++x )
+		{
+			Uint8 type = chunk.tiles[ ( y - firstY ) * CHUNK_SIZE + ( x - firstX ) ];
+			SDL_FRect uv = sheetTexture.getTextureCoords( &clips[ type ] );
+
+			float left = x * TILE_WIDTH;
+			float top = y * TILE_HEIGHT;
+			float right = left + TILE_WIDTH;
+			float bottom = top + TILE_HEIGHT;
+
+			// Same corner order as SpriteBatch::drawQuad
+			chunk.vertices.push_back( { { left,  top    }, white, { uv.x,        uv.y        } } );
+			chunk.vertices.push_back( { { right, top    }, white, { uv.x + uv.w, uv.y        } } );
+			chunk.vertices.push_back( { { right, bottom }, white, { uv.x + uv.w, uv.y + uv.h } } );
+			chunk.vertices.push_back( { { left,  bottom }, white, { uv.x,        uv.y + uv.h } } );
+		}
+	}
+
+	chunk.dirty = false;
+}
@@ -0,0 +1,242 @@
+#include "../headers/trace_recorder.h"
+#include <string.h>
+
+TraceRecorder::TraceRecorder()
+{
+    front.resize(BUFFER_EVENTS);
+    back.resize(BUFFER_EVENTS);
+}
+
+TraceRecorder& TraceRecorder::get()
+{
+    // Never destroyed, like the other engine singletons
+    static TraceRecorder* instance = new TraceRecorder();
+    return *instance;
+}
+
+bool TraceRecorder::start(std::string path)
+{
+    if (recording)
+    {
+        return false;
+    }
+
+    file = fopen(path.c_str(), "w");
+    if (file == NULL)
+    {
+        printf( "Unable to open trace file %s!\n", path.c_str() );
+        return false;
+    }
+
+    fputs("{\"traceEvents\":[\n", file);
+
+    frontCount = 0;
+    backCount = 0;
+    backPending = false;
+    stopping = false;
+    firstEvent = true;
+    droppedEvents = 0;
+    startTicks = SDL_GetPerformanceCounter();
+
+    writer = std::thread(&TraceRecorder::writerLoop, this);
+    recording = true;
+
+    printf( "Recording trace to %s\n", path.c_str() );
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (!recording)
+    {
+        return;
+    }
+
+    recording = false;
+    flush(true);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+    fclose(file);
+    file = NULL;
+
+    if (droppedEvents > 0)
+    {
+        printf( "Trace dropped %d events, the writer could not keep up\n", droppedEvents );
+    }
+}
+
+bool TraceRecorder::isRecording()
+{
+    return recording;
+}
+
+void TraceRecorder::recordSlice(const char* name, Uint64 beginTicks, Uint64 endTicks)
+{
+    if (!recording)
+    {
+        return;
+    }
+
+    // Scopes open when the trace started, like the frame that pressed F4,
+    // are cut to the part that was recorded
+    if (beginTicks < startTicks)
+    {
+        beginTicks = startTicks;
+    }
+    if (endTicks < beginTicks)
+    {
+        endTicks = beginTicks;
+    }
+
+    Event event;
+    event.name = name;
+    event.category = "scope";
+    event.phase = 'X';
+    event.timestamp = toMicroseconds(beginTicks - startTicks);
+    event.duration = toMicroseconds(endTicks - beginTicks);
+    event.detail[0] = '\0';
+    push(event);
+}
+
+void TraceRecorder::recordInstant(const char* category, const char* name, const char* detail)
+{
+    if (!recording)
+    {
+        return;
+    }
+
+    Uint64 ticks = SDL_GetPerformanceCounter();
+    if (ticks < startTicks)
+    {
+        ticks = startTicks;
+    }
+
+    Event event;
+    event.name = name;
+    event.category = category;
+    event.phase = 'i';
+    event.timestamp = toMicroseconds(ticks - startTicks);
+    event.duration = 0.0;
+    event.detail[0] = '\0';
+    if (detail != NULL)
+    {
+        strncpy(event.detail, detail, DETAIL_LENGTH - 1);
+        event.detail[DETAIL_LENGTH - 1] = '\0';
+    }
+    push(event);
+}
+
+int TraceRecorder::getDroppedEvents()
+{
+    return droppedEvents;
+}
+
+void TraceRecorder::push(const Event& event)
+{
+    // Never block the frame: if the writer still owns the other buffer, drop
+    if (frontCount == BUFFER_EVENTS && !flush(false))
+    {
+        droppedEvents++;
+        return;
+    }
+
+    front[frontCount++] = event;
+
+    // Hand over early so the writer has time before this buffer fills
+    if (frontCount >= BUFFER_EVENTS / 2)
+    {
+        flush(false);
+    }
+}
+
+bool TraceRecorder::flush(bool wait)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (backPending)
+    {
+        if (!wait)
+        {
+            return false;
+        }
+        wake.wait(lock, [this] { return !backPending; });
+    }
+
+    front.swap(back);
+    backCount = frontCount;
+    frontCount = 0;
+    backPending = true;
+
+    lock.unlock();
+    wake.notify_one();
+    return true;
+}
+
+void TraceRecorder::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this] { return backPending || stopping; });
+
+        if (backPending)
+        {
+            // The back buffer is ours until backPending is cleared
+            lock.unlock();
+            for (int i = 0; i < backCount; i++)
+            {
+                writeEvent(back[i]);
+            }
+            lock.lock();
+
+            backPending = false;
+            wake.notify_one();
+        }
+        else if (stopping)
+        {
+            break;
+        }
+    }
+}
+
+void TraceRecorder::writeEvent(const Event& event)
+{
+    if (!firstEvent)
+    {
+        fputs(",\n", file);
+    }
+    firstEvent = false;
+
+    if (event.phase == 'X')
+    {
+        fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}",
+            event.name, event.category, event.timestamp, event.duration);
+        return;
+    }
+
+    fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":1,\"args\":{\"detail\":\"",
+        event.name, event.category, event.timestamp);
+
+    // Paths may contain backslashes on Windows
+    for (const char* c = event.detail; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            fputc('\\', file);
+        }
+        fputc(*c, file);
+    }
+
+    fputs("\"}}", file);
+}
+
+double TraceRecorder::toMicroseconds(Uint64 ticks)
+{
+    return ticks * 1000000.0 / SDL_GetPerformanceFrequency();
+}
@@ -6,6 +6,26 @@ UIObject::UIObject( int x, int y, int w, int h )
     setSize(w, h);
 }
 
+UIObject::UIObject( const UIObject& other )
+{
+    *this = other;
+}
+
+UIObject& UIObject::operator=( const UIObject& other )
+{
+    if( this == &other )
+    {
+        return *this;
+    }
+
+    texture = other.texture.share();
+    position = other.position;
+    size = other.size;
+    crop = other.crop;
+
+    return *this;
+}
+
 void UIObject::setSize( int w, int h )
 {
     size.set(w, h);
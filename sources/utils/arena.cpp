@@ -0,0 +1,69 @@
+#include "../../headers/utils/arena.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+Arena::Arena(size_t blockSize)
+{
+    this->blockSize = blockSize;
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - (uintptr_t)current % alignment) % alignment;
+    if (current == nullptr || padding + size > remaining)
+    {
+        addBlock(size + alignment);
+        padding = (alignment - (uintptr_t)current % alignment) % alignment;
+    }
+
+    char* memory = current + padding;
+    current += padding + size;
+    remaining -= padding + size;
+    bytesUsed += size;
+    return memory;
+}
+
+void Arena::release()
+{
+    for (char* block : blocks)
+    {
+        free(block);
+    }
+    blocks.clear();
+
+    current = nullptr;
+    remaining = 0;
+    bytesUsed = 0;
+}
+
+size_t Arena::getBlockAmount()
+{
+    return blocks.size();
+}
+
+size_t Arena::getBytesUsed()
+{
+    return bytesUsed;
+}
+
+void Arena::addBlock(size_t minimumSize)
+{
+    // Oversized requests get a block of their own size
+    size_t size = minimumSize > blockSize ? minimumSize : blockSize;
+
+    char* block = (char*)malloc(size);
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    blocks.push_back(block);
+    current = block;
+    remaining = size;
+}
@@ -0,0 +1,57 @@
+#include "../../headers/utils/obb.h"
+
+void OBB::set(const Vector2D& position, const Vector2D& size, float rotation)
+{
+    halfExtents[0] = size.getX() / 2;
+    halfExtents[1] = size.getY() / 2;
+
+    center.set(position.getX() + halfExtents[0], position.getY() + halfExtents[1]);
+
+    float radians = rotation * (M_PI / 180.0);
+    float cosine = std::cos(radians);
+    float sine = std::sin(radians);
+
+    axes[0].set(cosine, sine);
+    axes[1].set(-sine, cosine);
+
+    Vector2D halfX = axes[0] * halfExtents[0];
+    Vector2D halfY = axes[1] * halfExtents[1];
+
+    corners[0] = center - halfX - halfY;
+    corners[1] = center + halfX - halfY;
+    corners[2] = center - halfX + halfY;
+    corners[3] = center + halfX + halfY;
+}
+
+float OBB::getProjectedRadius(const Vector2D& axis) const
+{
+    return halfExtents[0] * std::fabs(axes[0].dot(axis)) + halfExtents[1] * std::fabs(axes[1].dot(axis));
+}
+
+bool OBB::intersects(const OBB& other, Vector2D& normal, float& depth) const
+{
+    const Vector2D* testAxes[4] = { &axes[0], &axes[1], &other.axes[0], &other.axes[1] };
+
+    Vector2D offset = center - other.center;
+
+    depth = -1;
+    for (int i = 0; i < 4; i++)
+    {
+        const Vector2D& axis = *testAxes[i];
+
+        float distance = offset.dot(axis);
+        float overlap = getProjectedRadius(axis) + other.getProjectedRadius(axis) - std::fabs(distance);
+        if (overlap <= 0)
+        {
+            return false;
+        }
+
+        if (depth < 0 || overlap < depth)
+        {
+            depth = overlap;
+            normal = distance < 0 ? Vector2D(-axis.getX(), -axis.getY()) : axis;
+        }
+    }
+
+    return true;
+}
@@ -121,3 +121,8 @@ Vector2D Vector2D::getNormalizedVector()
     }
     return {newX, newY};
 }
+
+float Vector2D::dot(const Vector2D& v2) const
+{
+    return x * v2.x + y * v2.y;
+}
\ No newline at end of file
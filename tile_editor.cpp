@@ -12,10 +12,9 @@
 #include <map>
 
 #include "./headers/texture.h"
-#include "./headers/particle.h"
+#include "./headers/particle_system.h"
 #include "./headers/player.h"
 #include "./headers/timer.h"
-#include "./headers/tile.h"
 #include "./headers/button.h"
 #include "./headers/tile_map.h"
 #include "./headers/audio_source.h"
@@ -226,36 +225,11 @@ bool loadMedia()
 	player.addAnimation("./resources/playeranim3.png", renderer);
 	player.addAnimation("./resources/playeranim4.png", renderer);
 
-    for(int i = 0; i < player.TOTAL_PARTICLES; i++) {
-        if( !player.particles[i]->redTexture.loadFromFile( "./resources/red.bmp", renderer ) )
-        {
-            printf( "Failed to load red texture!\n" );
-            success = false;
-        }
-
-        if( !player.particles[i]->greenTexture.loadFromFile( "./resources/green.bmp", renderer ) )
-        {
-            printf( "Failed to load green texture!\n" );
-            success = false;
-        }
-
-        if( !player.particles[i]->blueTexture.loadFromFile( "./resources/blue.bmp", renderer ) )
-        {
-            printf( "Failed to load blue texture!\n" );
-            success = false;
-        }
-
-        if( !player.particles[i]->shimmerTexture.loadFromFile( "./resources/shimmer.bmp", renderer ) )
-        {
-            printf( "Failed to load shimmer texture!\n" );
-            success = false;
-        }
-	
-	    player.particles[i]->redTexture.setAlpha( 192 );
-	    player.particles[i]->greenTexture.setAlpha( 192 );
-	    player.particles[i]->blueTexture.setAlpha( 192 );
-	    player.particles[i]->shimmerTexture.setAlpha( 192 );
+    if( !player.particles.loadTextures( renderer, { "./resources/red.bmp", "./resources/green.bmp", "./resources/blue.bmp" }, "./resources/shimmer.bmp" ) )
+    {
+        success = false;
     }
+    player.particles.setAlpha( 192 );
 
 	return success;
 }
@@ -276,12 +250,7 @@ void close()
 	Mix_FreeMusic( audioSource.getMusic(0) );
 	// gMusic = NULL;
 
-    for(int i = 0; i < player.TOTAL_PARTICLES; i++) {
-        player.particles[i]->redTexture.free();
-        player.particles[i]->greenTexture.free();
-        player.particles[i]->blueTexture.free();
-        player.particles[i]->shimmerTexture.free();
-    }
+    player.particles.freeTextures();
 
 	canvas.freeTextures();
 	selectionCanvas.freeTextures();
@@ -423,11 +392,9 @@ int main( int argc, char* args[] )
 							switch( e.type )
 							{
 								case SDL_MOUSEBUTTONDOWN:
-								int tileX = (mouseX / TILE_WIDTH);
-								int tileY = (mouseY / TILE_HEIGHT);
-								int index = tileMap.getTileFromScreenPosition(mouseX, mouseY);
-								Tile* t = new Tile( tileX*TILE_WIDTH, tileY*TILE_HEIGHT, currentTile );
-								tileMap.setTile(index, t);
+								int tileX = ((mouseX + camera.x) / TILE_WIDTH);
+								int tileY = ((mouseY + camera.y) / TILE_HEIGHT);
+								tileMap.setTile(tileX, tileY, currentTile);
 								break;
 							}
 						}
@@ -468,6 +435,7 @@ int main( int argc, char* args[] )
 				{
 					saveButton.setToggle(false);
 					tileMap.saveTilesToFile(field.getContent());
+					tileMap.saveBinary(field.getContent());
 				}
 
 				float avgFPS = countedFrames / ( fpsTimer.getTicks() / 1000.f );
@@ -481,8 +449,8 @@ int main( int argc, char* args[] )
                 FPSText.updateContent(timeText.str());
                 FPSText.loadTexture(renderer);
 
-				player.move( tileMap.getTiles() );
-				player.setCamera( camera );
+				player.move( tileMap );
+				player.setCamera( camera, tileMap );
 
 				SDL_SetRenderDrawColor( renderer, 0xFF, 0xFF, 0xFF, 0xFF );
 				SDL_RenderClear( renderer );